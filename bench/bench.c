@@ -0,0 +1,629 @@
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "config.h"
+#include "bullets.h"
+#include "stars.h"
+#include "kernels.h"
+#include "rng.h"
+#include "spatial_hash.h"
+#include "enemies.h"
+#include "emitters.h"
+#include "particles.h"
+#include "jobs.h"
+#include "animation.h"
+#include "atlas.h"
+#include "ecs.h"
+#include "systems.h"
+#include "pickups.h"
+
+// -----------------------------------------------------------------------------
+// Microbenchmarks for the simulation hot paths
+// -----------------------------------------------------------------------------
+// Runs without a window: only the update/spawn code is exercised, except for
+// the StarDraw comparison, which opens a hidden one when a display exists. Each case
+// sweeps entity counts by powers of ten, does warmup passes, then times
+// BENCH_REPS repetitions and reports the best and median ns per entity.
+// Build through `make bench`, which raises the pool capacities to
+// BENCH_MAX_ENTITIES.
+
+// -----------------------------------------------------------------------------
+// Constants
+// -----------------------------------------------------------------------------
+#define BENCH_MIN_ENTITIES 100
+#define BENCH_MAX_ENTITIES 1000000
+#define BENCH_WARMUP 3
+#define BENCH_REPS 9
+#define BENCH_WORK_PER_REP 4000000L // Entity-updates per timed repetition
+#define BENCH_DT SIM_DT
+#define BENCH_COLLISION_BULLETS 10000
+#define BENCH_COLLISION_TARGETS 1000
+#define BENCH_TARGET_RADIUS 12.0f
+#define BENCH_MAX_PAIRS (1 << 20)
+#define BENCH_BURST 5000
+#define BENCH_PARTICLE_TARGET 50000   // Live particles the budget is stated for
+#define BENCH_PARTICLE_BUDGET_MS 2.0  // Update + draw per frame
+#define BENCH_JOB_TICKS 120           // Ticks compared serial vs threaded
+#define BENCH_TUNNEL_SPEED 6000.0f    // px/s, crosses a target in one long frame
+#define BENCH_TUNNEL_DT (1.0f / 30.0f)
+#define BENCH_STAR_DRAW_MAX 100000    // Largest star count drawn per frame
+#define BENCH_STAR_DRAW_FRAMES 200    // Frames timed per star count and path
+
+#if SHIP_MAX_BULLETS < BENCH_MAX_ENTITIES || MAX_STARS < BENCH_MAX_ENTITIES || MAX_ENEMIES < BENCH_MAX_ENTITIES || \
+    MAX_PARTICLES < BENCH_MAX_ENTITIES || MAX_ANIMATIONS < BENCH_MAX_ENTITIES || ECS_MAX_ENTITIES < BENCH_MAX_ENTITIES
+#error "build the benchmark through `make bench` so the pools are large enough"
+#endif
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct BenchCase {
+    const char *name;
+    void (*setup)(int n);        // Untimed, before every repetition
+    void (*run)(int n);          // Timed, one pass over n entities
+    bool perCall;                // Report ns per call instead of per entity
+} BenchCase;
+
+typedef void (*BulletKernel)(float *x, float *y, const float *vx, const float *vy,
+                             unsigned char *offscreen, int n, float dt);
+typedef void (*SweepKernel)(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                            const SweepTarget *target, float *toi, int *hit);
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+static volatile int sink; // Keeps results of pure calls alive
+static BulletKernel bulletKernel;
+static SweepKernel sweepKernel;
+static int kernelHit[BENCH_MAX_ENTITIES];
+static float kernelToi[BENCH_MAX_ENTITIES];
+static const char *filter; // Optional substring filter on case names
+
+static float targetX[BENCH_COLLISION_TARGETS];
+static float targetY[BENCH_COLLISION_TARGETS];
+static float targetRadius[BENCH_COLLISION_TARGETS];
+static float targetPrevX[BENCH_COLLISION_TARGETS];
+static float targetPrevY[BENCH_COLLISION_TARGETS];
+static int sweptHit[BENCH_COLLISION_BULLETS];
+static int oracleSweptHit[BENCH_COLLISION_BULLETS];
+static float sweptToi[BENCH_COLLISION_BULLETS];
+static float oracleSweptToi[BENCH_COLLISION_BULLETS];
+static SpatialHash targetHash;
+static CollisionPair pairs[BENCH_MAX_PAIRS];
+static CollisionPair oraclePairs[BENCH_MAX_PAIRS];
+
+// -----------------------------------------------------------------------------
+// Timing
+// -----------------------------------------------------------------------------
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int CompareDoubles(const void *a, const void *b) {
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+static void RunCase(const BenchCase *bench, int n) {
+    // Per-entity cases scale passes so every repetition does the same work;
+    // per-call cases are O(1) and get a fixed number of calls
+    long passes = bench->perCall ? BENCH_WORK_PER_REP : BENCH_WORK_PER_REP / n;
+    if (passes < 1) passes = 1;
+
+    double samples[BENCH_REPS];
+    for (int rep = -BENCH_WARMUP; rep < BENCH_REPS; rep++) {
+        bench->setup(n);
+        double start = NowSeconds();
+        for (long pass = 0; pass < passes; pass++) {
+            bench->run(n);
+        }
+        double elapsed = NowSeconds() - start;
+        if (rep >= 0) {
+            double units = bench->perCall ? (double)passes : (double)passes * n;
+            samples[rep] = elapsed * 1e9 / units;
+        }
+    }
+
+    qsort(samples, BENCH_REPS, sizeof(double), CompareDoubles);
+    printf("%-26s %9d %10.3f %10.3f  ns/%s\n", bench->name, n,
+           samples[0], samples[BENCH_REPS / 2], bench->perCall ? "call" : "entity");
+}
+
+// -----------------------------------------------------------------------------
+// Cases
+// -----------------------------------------------------------------------------
+static void SpawnBullets(int n) {
+    // Parked on the field with no velocity, so none are culled while timed
+    InitBullets();
+    for (int i = 0; i < n; i++) {
+        ShootBullet((Vector2){ (float)(i % SCREEN_WIDTH), (float)(i % SCREEN_HEIGHT) });
+        bullets.vy[i] = 0.0f;
+    }
+}
+
+static void SpawnEnemies(int n) {
+    // Slow enough that none leave the field while being timed
+    InitEnemies();
+    for (int i = 0; i < n; i++) {
+        SpawnEnemy((EnemyPattern)(i % ENEMY_PATTERN_COUNT), (float)(i % SCREEN_WIDTH), 0.001f, 1.0f, 40.0f);
+    }
+}
+
+static void SpawnParticles(int n) {
+    // Long-lived and at rest so none retire while timed and drag never
+    // decays velocities into denormals; the ring starts mid-buffer so the
+    // wrapped two-span path is the one measured
+    InitParticles(1);
+    particles.tail = MAX_PARTICLES - n / 2;
+    for (int i = 0; i < n; i++) {
+        SpawnParticle((Vector2){ (float)(i % SCREEN_WIDTH), (float)(i % SCREEN_HEIGHT) },
+                      (Vector2){ 0.0f, 0.0f }, 1e6f, 1.0f, WHITE);
+    }
+}
+
+static void SpawnAnimations(int n) {
+    // Alternate timed and banking slots so both paths are in the pass
+    InitAnimations();
+    for (int i = 0; i < n; i++) {
+        int slot = CreateAnimation((AnimationClipId)(i % ANIM_CLIP_COUNT));
+        SetAnimationBlend(slot, (i & 2) ? 1.0f : -1.0f);
+    }
+}
+
+static void SpawnEntities(int n) {
+    // Pickups at rest that never expire, so the world keeps its size while
+    // the shared systems run over it
+    InitWorld();
+    for (int i = 0; i < n; i++) {
+        Entity pickup = SpawnPickup((Vector2){ (float)(i % SCREEN_WIDTH), (float)(i % SCREEN_HEIGHT) });
+        *(Vector2 *)GetComponent(pickup, COMPONENT_VELOCITY) = (Vector2){ 0.0f, 0.0f };
+        *(float *)GetComponent(pickup, COMPONENT_LIFETIME) = 1e30f;
+    }
+}
+
+static void SetupNothing(int n) { (void)n; }
+static void SetupStars(int n) { InitStars(1, n); }
+
+static void RunShootBullet(int n) { SpawnBullets(n); }
+static void RunUpdateBullets(int n) { (void)n; UpdateBullets(BENCH_DT); }
+static void RunUpdateStars(int n) { (void)n; UpdateStars(BENCH_DT); }
+static void RunCountActiveBullets(int n) { (void)n; sink = CountActiveBullets(); }
+static void RunUpdateEnemies(int n) { (void)n; UpdateEnemies(BENCH_DT); }
+static void RunUpdateAnimations(int n) { (void)n; UpdateAnimations(BENCH_DT); }
+static void RunUpdateParticles(int n) { (void)n; UpdateParticles(BENCH_DT); }
+static void RunUpdateEntities(int n) { (void)n; UpdateEntities(BENCH_DT); }
+static void RunSpawnExplosions(int n) { SpawnExplosion((Vector2){ 400.0f, 300.0f }, n, WHITE); }
+
+static void RunBurstOneByOne(int n) {
+    // Baseline: a ring built from n single spawns with per-bullet sin/cos
+    InitBullets();
+    for (int i = 0; i < n; i++) {
+        float angle = EMITTER_FULL_CIRCLE * i / n;
+        ShootBullet((Vector2){ SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f });
+        bullets.vx[bullets.count - 1] = cosf(angle) * 200.0f;
+        bullets.vy[bullets.count - 1] = sinf(angle) * 200.0f;
+    }
+}
+
+static void RunBurstVolley(int n) {
+    BulletPattern ring = { .count = n, .spread = EMITTER_FULL_CIRCLE, .speed = 200.0f };
+    InitBullets();
+    sink = EmitVolley(&ring, (Vector2){ SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f }, 0.0f);
+}
+
+static void RunBulletKernel(int n) {
+    bulletKernel(bullets.x, bullets.y, bullets.vx, bullets.vy, bullets.offscreen, n, BENCH_DT);
+}
+
+static void RunSweepKernel(int n) {
+    // One target against every bullet, as each broadphase candidate is
+    SweepTarget target = { .x = SCREEN_WIDTH / 2.0f, .y = SCREEN_HEIGHT / 2.0f, .dx = 1.0f,
+                           .radius = BENCH_TARGET_RADIUS, .halfWidth = BENCH_TARGET_RADIUS,
+                           .halfHeight = BENCH_TARGET_RADIUS, .id = 0 };
+    sweepKernel(bullets.x, bullets.y, bullets.vx, bullets.vy, n, BENCH_DT, &target, kernelToi, kernelHit);
+}
+
+static void SpawnFieldBullets(int n) {
+    // Bullets and targets spread uniformly over the play field
+    Rng rng;
+    RngSeed(&rng, 2);
+    InitBullets();
+    for (int i = 0; i < n; i++) {
+        Vector2 position = { RngRange(&rng, 0.0f, SCREEN_WIDTH), RngRange(&rng, 0.0f, SCREEN_HEIGHT) };
+        ShootBullet(position);
+    }
+    RngFillRange(&rng, targetX, BENCH_COLLISION_TARGETS, 0.0f, SCREEN_WIDTH);
+    RngFillRange(&rng, targetY, BENCH_COLLISION_TARGETS, 0.0f, SCREEN_HEIGHT);
+    for (int i = 0; i < BENCH_COLLISION_TARGETS; i++) {
+        targetRadius[i] = BENCH_TARGET_RADIUS;
+        targetPrevX[i] = targetX[i] + RngRange(&rng, -1.0f, 1.0f); // About enemy speed per tick
+        targetPrevY[i] = targetY[i] + RngRange(&rng, -1.0f, 1.0f);
+    }
+}
+
+static void SpawnVolleyBullets(int n) {
+    // The same targets, with bullets fired as small rings the way emitters
+    // fire them, so consecutive pool slots sit close together
+    const BulletPattern ring = { .count = SWEEP_BATCH, .spread = EMITTER_FULL_CIRCLE, .speed = 300.0f };
+    SpawnFieldBullets(0);
+    Rng rng;
+    RngSeed(&rng, 4);
+    while (bullets.count < n) {
+        Vector2 origin = { RngRange(&rng, 0.0f, SCREEN_WIDTH), RngRange(&rng, 0.0f, SCREEN_HEIGHT) };
+        EmitVolley(&ring, origin, RngRange(&rng, 0.0f, EMITTER_FULL_CIRCLE));
+    }
+    IntegrateBullets(bullets.x, bullets.y, bullets.vx, bullets.vy, bullets.offscreen, bullets.count, BENCH_DT);
+}
+
+static void RunSpatialHash(int n) {
+    BuildSpatialHash(&targetHash, targetX, targetY, targetRadius, BENCH_COLLISION_TARGETS);
+    sink = QueryCollisionPairs(&targetHash, bullets.x, bullets.y, BULLET_RADIUS, n, pairs, BENCH_MAX_PAIRS);
+}
+
+static void RunBruteForce(int n) {
+    sink = BruteForceCollisionPairs(targetX, targetY, targetRadius, BENCH_COLLISION_TARGETS,
+                                    bullets.x, bullets.y, BULLET_RADIUS, n, pairs, BENCH_MAX_PAIRS);
+}
+
+static void RunSweptHash(int n) {
+    BuildSweptSpatialHash(&targetHash, targetX, targetY, targetPrevX, targetPrevY, targetRadius,
+                          BENCH_COLLISION_TARGETS);
+    sink = QuerySweptHits(&targetHash, bullets.x, bullets.y, bullets.vx, bullets.vy, BENCH_DT, BULLET_RADIUS, n,
+                          sweptHit, sweptToi);
+}
+
+static int ComparePairs(const void *a, const void *b) {
+    const CollisionPair *pa = a;
+    const CollisionPair *pb = b;
+    if (pa->bullet != pb->bullet) return (pa->bullet > pb->bullet) - (pa->bullet < pb->bullet);
+    return (pa->target > pb->target) - (pa->target < pb->target);
+}
+
+static void RunCollisionBench(void) {
+    const BenchCase cases[] = {
+        { "SpatialHash/1k-targets", SpawnFieldBullets, RunSpatialHash, false },
+        { "SweptHash/1k-targets", SpawnFieldBullets, RunSweptHash, false },
+        { "BruteForce/1k-targets", SpawnFieldBullets, RunBruteForce, false },
+        // Uniformly scattered bullets above are the swept query's worst
+        // case; volleys take the batched path
+        { "SpatialHash/volleys", SpawnVolleyBullets, RunSpatialHash, false },
+        { "SweptHash/volleys", SpawnVolleyBullets, RunSweptHash, false },
+    };
+    const int caseCount = (int)(sizeof(cases) / sizeof(cases[0]));
+    int n = BENCH_COLLISION_BULLETS;
+
+    // Check the broadphase against the brute-force oracle before timing it
+    if (filter == NULL || strstr("SpatialHash/oracle", filter) != NULL) {
+        SpawnFieldBullets(n);
+        BuildSpatialHash(&targetHash, targetX, targetY, targetRadius, BENCH_COLLISION_TARGETS);
+        int found = QueryCollisionPairs(&targetHash, bullets.x, bullets.y, BULLET_RADIUS, n, pairs, BENCH_MAX_PAIRS);
+        int expected = BruteForceCollisionPairs(targetX, targetY, targetRadius, BENCH_COLLISION_TARGETS,
+                                                bullets.x, bullets.y, BULLET_RADIUS, n, oraclePairs, BENCH_MAX_PAIRS);
+        qsort(pairs, found, sizeof(CollisionPair), ComparePairs);
+        qsort(oraclePairs, expected, sizeof(CollisionPair), ComparePairs);
+        bool match = found == expected && memcmp(pairs, oraclePairs, sizeof(CollisionPair) * found) == 0;
+        printf("%-26s %9d pairs, oracle %d pairs: %s\n", "SpatialHash/oracle", found, expected,
+               match ? "match" : "MISMATCH");
+    }
+
+    // Same for the swept query, with targets that moved this tick
+    if (filter == NULL || strstr("SweptHash/oracle", filter) != NULL) {
+        SpawnFieldBullets(n);
+        RunSweptHash(n);
+        int sweptHits = sink;
+        int oracleHits = BruteForceSweptHits(targetX, targetY, targetPrevX, targetPrevY, targetRadius,
+                                             BENCH_COLLISION_TARGETS, bullets.x, bullets.y, bullets.vx, bullets.vy,
+                                             BENCH_DT, BULLET_RADIUS, n, oracleSweptHit, oracleSweptToi);
+        bool match = memcmp(sweptHit, oracleSweptHit, sizeof(int) * n) == 0 &&
+                     memcmp(sweptToi, oracleSweptToi, sizeof(float) * n) == 0;
+        printf("%-26s %9d hits, oracle %d hits: %s\n", "SweptHash/oracle", sweptHits, oracleHits,
+               match ? "match" : "MISMATCH");
+    }
+
+    for (int c = 0; c < caseCount; c++) {
+        if (filter != NULL && strstr(cases[c].name, filter) == NULL) continue;
+        RunCase(&cases[c], n);
+    }
+}
+
+static void RunSweepChecks(void) {
+    if (filter != NULL && strstr("Sweep/tunnel", filter) == NULL && strstr("Sweep/simd-match", filter) == NULL) return;
+
+    // One bullet below each target of a row, fast enough to end a long
+    // frame as far above it: the point test never sees them touch
+    int row = SCREEN_WIDTH / (4 * BENCH_TARGET_RADIUS);
+    InitBullets();
+    for (int i = 0; i < row; i++) {
+        targetX[i] = targetPrevX[i] = (i + 0.5f) * 4 * BENCH_TARGET_RADIUS;
+        targetY[i] = targetPrevY[i] = SCREEN_HEIGHT / 2.0f;
+        targetRadius[i] = BENCH_TARGET_RADIUS;
+        ShootBullet((Vector2){ targetX[i], targetY[i] + BENCH_TUNNEL_SPEED * BENCH_TUNNEL_DT / 2.0f });
+        bullets.vy[i] = -BENCH_TUNNEL_SPEED;
+    }
+    IntegrateBullets(bullets.x, bullets.y, bullets.vx, bullets.vy, bullets.offscreen, row, BENCH_TUNNEL_DT);
+    BuildSweptSpatialHash(&targetHash, targetX, targetY, targetPrevX, targetPrevY, targetRadius, row);
+    int pointHits = QueryCollisionPairs(&targetHash, bullets.x, bullets.y, BULLET_RADIUS, row, pairs, BENCH_MAX_PAIRS);
+    int sweptHits = QuerySweptHits(&targetHash, bullets.x, bullets.y, bullets.vx, bullets.vy, BENCH_TUNNEL_DT,
+                                   BULLET_RADIUS, row, sweptHit, sweptToi);
+    printf("%-26s %9d bullets at %.0f px/s, point test %d hits, swept %d hits\n", "Sweep/tunnel", row,
+           BENCH_TUNNEL_SPEED, pointHits, sweptHits);
+
+    // The dispatched kernels against the scalar ones on scattered segments
+    Rng rng;
+    RngSeed(&rng, 3);
+    int n = BENCH_COLLISION_BULLETS;
+    SpawnFieldBullets(n);
+    RngFillRange(&rng, bullets.vx, n, -3000.0f, 3000.0f);
+    RngFillRange(&rng, bullets.vy, n, -3000.0f, 3000.0f);
+    bool match = true;
+    for (int shape = 0; shape < 2; shape++) {
+        for (int b = 0; b < n; b++) {
+            sweptHit[b] = oracleSweptHit[b] = -1;
+            sweptToi[b] = oracleSweptToi[b] = SWEEP_MISS;
+        }
+        for (int t = 0; t < 64; t++) {
+            SweepTarget target = {
+                .x = targetX[t], .y = targetY[t], .dx = targetX[t] - targetPrevX[t], .dy = targetY[t] - targetPrevY[t],
+                .radius = BENCH_TARGET_RADIUS, .halfWidth = BENCH_TARGET_RADIUS, .halfHeight = BENCH_TARGET_RADIUS / 2,
+                .id = t,
+            };
+            if (shape == 0) {
+                SweepCircle(bullets.x, bullets.y, bullets.vx, bullets.vy, n, BENCH_DT, &target, sweptToi, sweptHit);
+                SweepCircleScalar(bullets.x, bullets.y, bullets.vx, bullets.vy, n, BENCH_DT, &target, oracleSweptToi,
+                                  oracleSweptHit);
+            } else {
+                SweepBox(bullets.x, bullets.y, bullets.vx, bullets.vy, n, BENCH_DT, &target, sweptToi, sweptHit);
+                SweepBoxScalar(bullets.x, bullets.y, bullets.vx, bullets.vy, n, BENCH_DT, &target, oracleSweptToi,
+                               oracleSweptHit);
+            }
+        }
+        match = match && memcmp(sweptHit, oracleSweptHit, sizeof(int) * n) == 0 &&
+                memcmp(sweptToi, oracleSweptToi, sizeof(float) * n) == 0;
+    }
+    printf("%-26s %9d segments, %s vs scalar: %s\n", "Sweep/simd-match", n, SIMD_PATH_NAME,
+           match ? "match" : "MISMATCH");
+}
+
+static bool HaveDisplay(void) {
+    // InitWindow does not survive a missing display, so check up front
+    return getenv("DISPLAY") != NULL || getenv("WAYLAND_DISPLAY") != NULL;
+}
+
+static void RunParticleBudget(void) {
+    if (filter != NULL && strstr("Particles/budget", filter) == NULL) return;
+
+    // One simulated frame's worth of particle updates (the windowed loop
+    // averages SIM_HZ / 60 ticks per frame) at the target population
+    int n = BENCH_PARTICLE_TARGET;
+    int ticksPerFrame = SIM_HZ / 60;
+    double update = 1e30;
+    for (int rep = -BENCH_WARMUP; rep < BENCH_REPS; rep++) {
+        SpawnParticles(n);
+        double start = NowSeconds();
+        for (int tick = 0; tick < ticksPerFrame; tick++) {
+            UpdateParticles(BENCH_DT);
+        }
+        double elapsed = NowSeconds() - start;
+        if (rep >= 0 && elapsed < update) update = elapsed;
+    }
+    if (!HaveDisplay()) {
+        printf("%-26s %9d %10.3f ms/frame update, draw skipped, no display: budget not checked\n",
+               "Particles/budget", n, update * 1e3);
+        return;
+    }
+
+    // Draw the same population into a hidden window's render texture, timed
+    // as CPU-side submission like StarDraw
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "shmup_bench");
+    InitAtlas();
+    RenderTexture2D target = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    SpawnParticles(n);
+    UpdateParticles(BENCH_DT);
+    double draw = 1e30;
+    for (int frame = -BENCH_WARMUP; frame < BENCH_REPS; frame++) {
+        double start = NowSeconds();
+        BeginTextureMode(target);
+        ClearBackground(BLACK);
+        DrawParticles(&particles, 0.5f);
+        EndTextureMode();
+        double elapsed = NowSeconds() - start;
+        if (frame >= 0 && elapsed < draw) draw = elapsed;
+    }
+    UnloadRenderTexture(target);
+    UnloadAtlas();
+    CloseWindow();
+
+    double total = (update + draw) * 1e3;
+    printf("%-26s %9d %10.3f ms/frame update, %.3f draw, %.3f total of %.1f ms: %s\n", "Particles/budget", n,
+           update * 1e3, draw * 1e3, total, BENCH_PARTICLE_BUDGET_MS,
+           total <= BENCH_PARTICLE_BUDGET_MS ? "PASS" : "FAIL");
+}
+
+static uint32_t HashFloats(uint32_t hash, const float *values, int n) {
+    // FNV-1a, like StarFieldChecksum
+    const unsigned char *bytes = (const unsigned char *)values;
+    for (size_t b = 0; b < sizeof(float) * (size_t)n; b++) {
+        hash = (hash ^ bytes[b]) * 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t SimulateForJobCheck(void) {
+    SpawnFieldBullets(BENCH_MAX_ENTITIES);
+    SpawnEnemies(BENCH_MAX_ENTITIES);
+    for (int tick = 0; tick < BENCH_JOB_TICKS; tick++) {
+        UpdateBullets(BENCH_DT);
+        UpdateEnemies(BENCH_DT);
+    }
+    uint32_t hash = 2166136261u ^ (uint32_t)bullets.count ^ ((uint32_t)enemies.count << 16);
+    hash = HashFloats(hash, bullets.x, bullets.count);
+    hash = HashFloats(hash, bullets.y, bullets.count);
+    hash = HashFloats(hash, enemies.x, enemies.count);
+    return HashFloats(hash, enemies.y, enemies.count);
+}
+
+static void RunJobBench(void) {
+    const BenchCase cases[] = {
+        { "UpdateBullets", SpawnBullets, RunUpdateBullets, false },
+        { "UpdateEnemies", SpawnEnemies, RunUpdateEnemies, false },
+    };
+    if (filter != NULL && strstr("Jobs", filter) == NULL) return;
+
+    // The threaded run has to reproduce the serial one bit for bit
+    InitJobSystem(0);
+    uint32_t serial = SimulateForJobCheck();
+    InitJobSystem(JOB_WORKERS_AUTO);
+    uint32_t threaded = SimulateForJobCheck();
+    int workers = GetJobWorkerCount();
+    printf("%-26s %9d ticks, %d workers: %s\n", "Jobs/serial-match", BENCH_JOB_TICKS, workers,
+           serial == threaded ? "match" : "MISMATCH");
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        char name[32];
+        BenchCase bench = cases[c];
+        bench.name = name;
+
+        InitJobSystem(0);
+        snprintf(name, sizeof(name), "Jobs/%s/serial", cases[c].name);
+        RunCase(&bench, BENCH_MAX_ENTITIES);
+
+        InitJobSystem(JOB_WORKERS_AUTO);
+        snprintf(name, sizeof(name), "Jobs/%s/%dw", cases[c].name, workers);
+        RunCase(&bench, BENCH_MAX_ENTITIES);
+    }
+    ShutdownJobSystem();
+}
+
+static double TimeStarDraw(RenderTexture2D target, void (*draw)(const StarLayer *, float)) {
+    double best = 1e30;
+    for (int frame = -BENCH_WARMUP; frame < BENCH_STAR_DRAW_FRAMES; frame++) {
+        double start = NowSeconds();
+        BeginTextureMode(target);
+        ClearBackground(BLACK);
+        draw(stars.layers, 0.5f);
+        EndTextureMode();
+        double elapsed = NowSeconds() - start;
+        if (frame >= 0 && elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+static void RunStarDrawBench(void) {
+    if (filter != NULL && strstr("StarDraw", filter) == NULL) return;
+
+    // Baked tiles vs one rectangle per star, timed as CPU-side submission
+    // (EndTextureMode flushes the batch). Needs a GL context.
+    if (!HaveDisplay()) {
+        printf("%-26s skipped, no display\n", "StarDraw");
+        return;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "shmup_bench");
+    InitAtlas();
+    RenderTexture2D target = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    for (int n = BENCH_MIN_ENTITIES; n <= BENCH_STAR_DRAW_MAX; n *= 10) {
+        InitStars(1, n);
+        UpdateStars(0.37f); // Off a tile boundary so both tile copies are drawn
+        BakeStarTiles();
+        double perStar = TimeStarDraw(target, DrawStars);
+        double baked = TimeStarDraw(target, DrawStarsBaked);
+        printf("%-26s %9d %10.3f ms/frame per-star, %.3f ms/frame baked\n", "StarDraw", n,
+               perStar * 1e3, baked * 1e3);
+        UnloadStarTiles();
+    }
+
+    UnloadRenderTexture(target);
+    UnloadAtlas();
+    CloseWindow();
+}
+
+static void RunSweep(const BenchCase *bench) {
+    if (filter != NULL && strstr(bench->name, filter) == NULL) return;
+    for (int n = BENCH_MIN_ENTITIES; n <= BENCH_MAX_ENTITIES; n *= 10) {
+        RunCase(bench, n);
+    }
+}
+
+static void RunKernelSweeps(const char *path, BulletKernel bullet, SweepKernel circle, SweepKernel box) {
+    char bulletName[32], circleName[32], boxName[32];
+    snprintf(bulletName, sizeof(bulletName), "IntegrateBullets/%s", path);
+    snprintf(circleName, sizeof(circleName), "SweepCircle/%s", path);
+    snprintf(boxName, sizeof(boxName), "SweepBox/%s", path);
+
+    bulletKernel = bullet;
+    BenchCase bulletCase = { bulletName, SpawnBullets, RunBulletKernel, false };
+    RunSweep(&bulletCase);
+
+    BenchCase circleCase = { circleName, SpawnBullets, RunSweepKernel, false };
+    BenchCase boxCase = { boxName, SpawnBullets, RunSweepKernel, false };
+    sweepKernel = circle;
+    RunSweep(&circleCase);
+    sweepKernel = box;
+    RunSweep(&boxCase);
+}
+
+// -----------------------------------------------------------------------------
+// Main
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    // e.g. `./shmup_bench Stars` runs only the star cases
+    filter = argc > 1 ? argv[1] : NULL;
+
+    const BenchCase cases[] = {
+        { "ShootBullet", SetupNothing, RunShootBullet, false },
+        { "UpdateBullets", SpawnBullets, RunUpdateBullets, false },
+        { "UpdateStars", SetupStars, RunUpdateStars, true }, // Per layer, flat in the star count
+        { "CountActiveBullets", SpawnBullets, RunCountActiveBullets, true },
+        { "UpdateEnemies", SpawnEnemies, RunUpdateEnemies, false },
+        { "UpdateParticles", SpawnParticles, RunUpdateParticles, false },
+        { "SpawnExplosion", SetupNothing, RunSpawnExplosions, false },
+        { "UpdateAnimations", SpawnAnimations, RunUpdateAnimations, false },
+        { "UpdateEntities", SpawnEntities, RunUpdateEntities, false }, // Move, expire and cull over pickups
+    };
+
+    printf("simulation microbenchmarks, dispatch path %s, %d warmup + %d reps\n",
+           SIMD_PATH_NAME, BENCH_WARMUP, BENCH_REPS);
+    printf("%-26s %9s %10s %10s\n", "case", "entities", "best", "median");
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        RunSweep(&cases[c]);
+    }
+
+    const BenchCase burstCases[] = {
+        { "Burst/one-by-one", SetupNothing, RunBurstOneByOne, false },
+        { "Burst/EmitVolley", SetupNothing, RunBurstVolley, false },
+    };
+    for (size_t c = 0; c < sizeof(burstCases) / sizeof(burstCases[0]); c++) {
+        if (filter != NULL && strstr(burstCases[c].name, filter) == NULL) continue;
+        RunCase(&burstCases[c], BENCH_BURST);
+    }
+
+    RunCollisionBench();
+    RunSweepChecks();
+    RunParticleBudget();
+    RunJobBench();
+    RunStarDrawBench();
+
+    RunKernelSweeps("scalar", IntegrateBulletsScalar, SweepCircleScalar, SweepBoxScalar);
+#if defined(SHMUP_HAVE_SSE2)
+    RunKernelSweeps("sse2", IntegrateBulletsSse2, SweepCircleSse2, SweepBoxSse2);
+#endif
+#if defined(SHMUP_HAVE_AVX2)
+    RunKernelSweeps("avx2", IntegrateBulletsAvx2, SweepCircleAvx2, SweepBoxAvx2);
+#endif
+
+    return 0;
+}
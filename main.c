@@ -1,273 +1,637 @@
+#define _POSIX_C_SOURCE 200112L // clock_gettime, nanosleep, pthreads
+
 #include "raylib.h"
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "config.h"
+#include "bullets.h"
+#include "stars.h"
+#include "render_check.h"
+#include "profiler.h"
+#include "enemies.h"
+#include "particles.h"
+#include "waves.h"
+#include "emitters.h"
+#include "input.h"
+#include "replay.h"
+#include "atlas.h"
+#include "bundle.h"
+#include "jobs.h"
+#include "snapshot.h"
+#include "frame_stats.h"
+#include "animation.h"
+#include "ecs.h"
+#include "systems.h"
+#include "pickups.h"
+#include "arena.h"
 
 // -----------------------------------------------------------------------------
 // Constants
 // -----------------------------------------------------------------------------
-#define SCREEN_WIDTH 800
-#define SCREEN_HEIGHT 600
-#define SHIP_MAX_BULLETS 50
-#define MAX_STARS 100        // Define the maximum number of stars
-#define BASE_STAR_SCROLL_SPEED 530 // Base speed for the stars
-#define STAR_SPEED_VARIATION 320 // Range of random speed variation (+/-)
+#define HEADLESS_DEFAULT_FRAMES 1000000
+#define DEFAULT_WAVE_SCRIPT "assets/waves/default.txt"
 // -----------------------------------------------------------------------------
 // Types
 // -----------------------------------------------------------------------------
-typedef struct Bullet {
-    Vector2 position;
-    Vector2 velocity;
-    bool active;
-} Bullet;
-
 typedef struct Ship {
     Vector2 position;
-    Texture2D texture;
     float speed;
     float scale;
     Vector2 velocity; // This seems unused, consider removing if not needed.
+    int animation;    // Slot in the animation pool, banks with horizontal input
+    Vector2 previousPosition; // Position at the previous simulation tick, for interpolation
+    int pickups;              // Collected so far
+    int collisions;           // Enemies that flew into the ship so far
 } Ship;
 
-typedef struct Star {
-    Vector2 position;
-    float size;
-    Color color;
-    float speed;
-} Star;
+// Command line switches
+typedef struct GameOptions {
+    bool headless;
+    bool renderCheck;
+    bool seeded;                // --seed given; otherwise windowed runs seed from the clock
+    uint64_t seed;
+    long frames;                // 0 when not given; windowed runs then stop after N frames and print JSON
+    const char *wavePath;
+    const char *profileCsvPath;
+    const char *recordPath;
+    const char *replayPath;
+    int threads;                // Worker threads, JOB_WORKERS_AUTO unless --threads is given
+} GameOptions;
+
+// Shared by the render (main) thread and the simulation thread. Everything
+// else the simulation touches is owned by the simulation thread while it runs.
+typedef struct SimulationThread {
+    Ship *player;
+    InputReplay *replay;        // NULL unless replaying
+    InputRecorder *recorder;
+    SnapshotBuffer *snapshots;
+    uint8_t input;              // Latest packed keyboard input, written by the render thread
+    int quit;                   // Set by the render thread
+    int finished;               // Set by the simulation thread when a replay runs out
+} SimulationThread;
+
 // -----------------------------------------------------------------------------
 // Globals
 // -----------------------------------------------------------------------------
-Bullet bullets[SHIP_MAX_BULLETS];
-Star stars[MAX_STARS];
-
 float shootCooldown = 0.15f;       // Time between shots
 float timeSinceLastShot = 0.0f;
 
+WaveScript waves;
+
+// Spiral fired from the ship's nose while the special key is held
+const BulletPattern playerSpiralPattern = {
+    .count = 6,
+    .spread = EMITTER_FULL_CIRCLE,
+    .angle = -PI / 2.0f,
+    .angularVelocity = 2.5f,
+    .speed = 260.0f,
+    .interval = 0.06f
+};
+Emitter playerSpiral;
+
+static SnapshotBuffer snapshots;
+static FrameStats frameStats; // Render thread CPU time per frame
+static FrameStats tickStats;  // Simulation thread CPU time per tick
+
 // -----------------------------------------------------------------------------
 // Function Declarations
 // -----------------------------------------------------------------------------
-void InitBullets(void);
-void ShootBullet(Vector2 shipPos);
-void UpdateBullets(float deltaTime);
-void DrawBullets(void);
+PlayerInput ReadPlayerInput(void);
+PlayerInput ScriptedPlayerInput(long frame);
+void UpdatePlayer(Ship *player, PlayerInput input, float deltaTime);
+Vector2 GetShipCenter(const Ship *player);
 
-void InitStars(void);
-void UpdateStars(float deltaTime);
-void DrawStars(void);
+void InitSimulation(Ship *player, uint64_t seed, const char *wavePath);
+int StepSimulation(Ship *player, PlayerInput input);
 
+int RunHeadless(const GameOptions *options);
+
+void PublishSimulation(SnapshotBuffer *buffer, const Ship *player, uint64_t tick);
+void *SimulationThreadMain(void *arg);
+
+void WriteRunSummaryJson(FILE *file, long frames, const FrameStats *frameCpu);
 
 // -----------------------------------------------------------------------------
-// Bullet Functions
+// Player Functions
 // -----------------------------------------------------------------------------
-void InitBullets(void) {
-    for (int i = 0; i < SHIP_MAX_BULLETS; i++) {
-        bullets[i].active = false;
-    }
+PlayerInput ReadPlayerInput(void) {
+    PlayerInput input = {
+        .left = IsKeyDown(KEY_LEFT),
+        .right = IsKeyDown(KEY_RIGHT),
+        .up = IsKeyDown(KEY_UP),
+        .down = IsKeyDown(KEY_DOWN),
+        .shoot = IsKeyDown(KEY_SPACE),
+        .special = IsKeyDown(KEY_LEFT_SHIFT)
+    };
+    return input;
 }
 
-void ShootBullet(Vector2 shipPos) {
-    for (int i = 0; i < SHIP_MAX_BULLETS; i++) {
-        if (!bullets[i].active) {
-            bullets[i].position = shipPos;
-            bullets[i].velocity = (Vector2){ 0, -500 }; // Shoot upward
-            bullets[i].active = true;
-            break;
-        }
-    }
+PlayerInput ScriptedPlayerInput(long frame) {
+    // Weave left/right and up/down on different periods while holding fire,
+    // so the headless run exercises every branch of the player update
+    PlayerInput input = { 0 };
+    long phase = frame % 240;
+    input.right = phase < 120;
+    input.left = phase >= 120;
+    input.up = (frame / 90) % 2 == 0;
+    input.down = !input.up;
+    input.shoot = true;
+    input.special = (frame / 600) % 4 == 0;
+    return input;
 }
 
-void UpdateBullets(float deltaTime) {
-    for (int i = 0; i < SHIP_MAX_BULLETS; i++) {
-        if (bullets[i].active) {
-            bullets[i].position.x += bullets[i].velocity.x * deltaTime;
-            bullets[i].position.y += bullets[i].velocity.y * deltaTime;
+void UpdatePlayer(Ship *player, PlayerInput input, float deltaTime) {
+    player->previousPosition = player->position;
 
-            if (bullets[i].position.y < 0) {
-                bullets[i].active = false;
-            }
-        }
+    // Player Movement
+    if (input.right) player->position.x += player->speed * deltaTime;
+    if (input.left)  player->position.x -= player->speed * deltaTime;
+    if (input.down)  player->position.y += player->speed * deltaTime;
+    if (input.up)    player->position.y -= player->speed * deltaTime;
+
+    // Bank toward the held direction; the animation eases through the half
+    // frames and settles back to idle on release
+    SetAnimationBlend(player->animation, (float)input.right - (float)input.left);
+
+    // Adjust bullet spawn position based on the scaled ship size
+    Vector2 frameSize = GetSpriteSize(GetAnimationFrame(player->animation));
+    Vector2 bulletSpawnPos = {
+        player->position.x + (frameSize.x * player->scale / 2.0f), // Center horizontally
+        player->position.y                                                 // At the ship's Y position
+    };
+    // Move the bullet slightly above the ship (relative to scaled height)
+    bulletSpawnPos.y -= (frameSize.y * player->scale / 5.0f); // Adjust as needed for bullet to appear at ship's nose
+
+    timeSinceLastShot += deltaTime;
+    // Shooting
+    if (input.shoot && timeSinceLastShot >= shootCooldown) {
+        ShootBullet(bulletSpawnPos); // Fire the bullet
+        timeSinceLastShot = 0.0f; // Reset cooldown timer
     }
-}
 
-void DrawBullets(void) {
-    for (int i = 0; i < SHIP_MAX_BULLETS; i++) {
-        if (bullets[i].active) {
-            DrawCircleV(bullets[i].position, 5, RED);
-        }
+    // Special: the spiral emitter follows the nose; releasing the key resets
+    // it so the next press fires immediately
+    if (input.special) {
+        playerSpiral.position = bulletSpawnPos;
+        UpdateEmitter(&playerSpiral, bulletSpawnPos, deltaTime);
+    } else {
+        playerSpiral.timer = 0.0f;
     }
+
+    // Engine exhaust from the middle of the ship's tail
+    SpawnEngineTrail((Vector2){
+        player->position.x + frameSize.x * player->scale / 2.0f,
+        player->position.y + frameSize.y * player->scale
+    });
 }
 
-int CountActiveBullets(void) {
-    int count = 0;
-    for (int i = 0; i < SHIP_MAX_BULLETS; i++) {
-        if (bullets[i].active) {
-            count++;
-        }
-    }
-    return count;
+Vector2 GetShipCenter(const Ship *player) {
+    // position is the sprite's top-left corner
+    Vector2 frameSize = GetSpriteSize(GetAnimationFrame(player->animation));
+    return (Vector2){
+        player->position.x + frameSize.x * player->scale / 2.0f,
+        player->position.y + frameSize.y * player->scale / 2.0f
+    };
 }
 
 // -----------------------------------------------------------------------------
-// Star Functions
+// Simulation
 // -----------------------------------------------------------------------------
-void InitStars(void) {
-    // Initialize each star with a random position, size, color, and speed
-    for (int i = 0; i < MAX_STARS; i++) {
-        stars[i].position.x = (float)GetRandomValue(0, SCREEN_WIDTH);
-        stars[i].position.y = (float)GetRandomValue(0, SCREEN_HEIGHT);
-        stars[i].size = (float)GetRandomValue(1, 3);
-        stars[i].color = (Color){130, 130, 130, 255};
-        // Assign a random speed to each star
-        stars[i].speed = BASE_STAR_SCROLL_SPEED + (float)GetRandomValue(-STAR_SPEED_VARIATION, STAR_SPEED_VARIATION);
-        // Ensure the speed is not zero or negative (optional, but might look weird)
-        if (stars[i].speed <= 0) {
-            stars[i].speed = 1;
+void InitSimulation(Ship *player, uint64_t seed, const char *wavePath) {
+    // Everything a tick reads starts from the same state for the same seed,
+    // which is what makes replays reproducible
+    player->position = (Vector2){ SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f };
+    player->previousPosition = player->position;
+    timeSinceLastShot = 0.0f;
+
+    InitAnimations();
+    player->animation = CreateAnimation(ANIM_CLIP_SHIP_BANK); // Starts level, on the idle frame
+
+    InitBullets();
+    InitStars(seed, MAX_STARS);
+    InitEnemies();
+    InitParticles(seed);
+    InitWorld();
+    LoadWaveScript(&waves, wavePath);
+    InitEmitter(&playerSpiral, playerSpiralPattern, player->position);
+}
+
+int StepSimulation(Ship *player, PlayerInput input) {
+    // One fixed SIM_DT tick. Windowed, headless and replay runs all come
+    // through here. Returns the number of bullet hits this tick.
+    // Nothing allocated on scratch outlives a tick.
+    ResetScratch();
+
+    // Player Movement, Frame Selection and Shooting
+    ProfileBegin(PROFILE_PLAYER);
+    UpdatePlayer(player, input, SIM_DT);
+    UpdateAnimations(SIM_DT);
+    ProfileEnd(PROFILE_PLAYER);
+
+    // Update
+    ProfileBegin(PROFILE_BULLETS);
+    UpdateBullets(SIM_DT);
+    ProfileEnd(PROFILE_BULLETS);
+
+    ProfileBegin(PROFILE_STARS);
+    UpdateStars(SIM_DT);
+    ProfileEnd(PROFILE_STARS);
+
+    ProfileBegin(PROFILE_ENEMIES);
+    UpdateWaves(&waves, SIM_DT);
+    UpdateEnemies(SIM_DT);
+    int hits = ResolveBulletHits(SIM_DT);
+    Vector2 shipCenter = GetShipCenter(player);
+    Vector2 shipMoved = { player->position.x - player->previousPosition.x,
+                          player->position.y - player->previousPosition.y };
+    Vector2 frameSize = GetSpriteSize(GetAnimationFrame(player->animation));
+    Vector2 shipHalfSize = { frameSize.x * player->scale / 2.0f, frameSize.y * player->scale / 2.0f };
+    player->collisions += ResolveShipCollisions(shipCenter, shipMoved, shipHalfSize, SIM_DT);
+    ProfileEnd(PROFILE_ENEMIES);
+
+    ProfileBegin(PROFILE_PARTICLES);
+    UpdateParticles(SIM_DT);
+    ProfileEnd(PROFILE_PARTICLES);
+
+    ProfileBegin(PROFILE_ENTITIES);
+    UpdateEntities(SIM_DT);
+    player->pickups += CollectPickups(shipCenter);
+    ProfileEnd(PROFILE_ENTITIES);
+
+    return hits;
+}
+
+void PublishSimulation(SnapshotBuffer *buffer, const Ship *player, uint64_t tick) {
+    SimSnapshot *snapshot = BeginSnapshot(buffer);
+    snapshot->tick = tick;
+    snapshot->shipPosition = player->position;
+    snapshot->shipPreviousPosition = player->previousPosition;
+    snapshot->shipSource = animations.source[player->animation];
+    snapshot->shipScale = player->scale;
+    CaptureSnapshotPools(snapshot);
+    PublishSnapshot(buffer);
+}
+
+static void SleepNs(uint64_t ns) {
+    struct timespec ts = { (time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull) };
+    nanosleep(&ts, NULL);
+}
+
+void *SimulationThreadMain(void *arg) {
+    // Ticks at SIM_HZ on its own clock and publishes a snapshot after each
+    // one, so update cost overlaps with the render thread's GL submission
+    // instead of adding to it
+    SimulationThread *sim = arg;
+    const uint64_t tickNs = (uint64_t)(1e9 / SIM_HZ);
+    uint64_t nextTick = ProfileNowNs();
+    uint64_t tick = 0;
+
+    while (!__atomic_load_n(&sim->quit, __ATOMIC_ACQUIRE)) {
+        uint64_t now = ProfileNowNs();
+        if (now < nextTick) {
+            SleepNs(nextTick - now);
+            continue;
+        }
+        // After a long stall, drop the backlog instead of fast-forwarding
+        if (now - nextTick > (uint64_t)(MAX_FRAME_TIME * 1e9)) nextTick = now;
+
+        // A replay supplies its own input for every tick
+        PlayerInput input = UnpackPlayerInput(__atomic_load_n(&sim->input, __ATOMIC_RELAXED));
+        if (sim->replay != NULL && !NextReplayInput(sim->replay, &input)) {
+            __atomic_store_n(&sim->finished, 1, __ATOMIC_RELEASE);
+            break;
         }
+        RecordInput(sim->recorder, input);
+
+        uint64_t cpuStart = ThreadCpuNowNs();
+        StepSimulation(sim->player, input);
+        PublishSimulation(sim->snapshots, sim->player, ++tick);
+        RecordFrameTime(&tickStats, ThreadCpuNowNs() - cpuStart);
+        nextTick += tickNs;
     }
+    return NULL;
 }
 
-void UpdateStars(float deltaTime) {
-    // Update the vertical position of each star based on its individual speed
-    for (int i = 0; i < MAX_STARS; i++) {
-        stars[i].position.y += stars[i].speed * deltaTime;
-
-        // If a star goes off the bottom of the screen, reset its position and properties
-        if (stars[i].position.y > SCREEN_HEIGHT) {
-            stars[i].position.y = (float)GetRandomValue(-5, 0);
-            stars[i].position.x = (float)GetRandomValue(0, SCREEN_WIDTH);
-            stars[i].size = (float)GetRandomValue(1, 3);
-            stars[i].color = (Color){130, 130, 130, 255};
-            // Assign a new random speed when the star resets
-            stars[i].speed = BASE_STAR_SCROLL_SPEED + (float)GetRandomValue(-STAR_SPEED_VARIATION, STAR_SPEED_VARIATION);
-            if (stars[i].speed <= 0) {
-                stars[i].speed = 1;
-            }
-        }
+// -----------------------------------------------------------------------------
+// Run Summary
+// -----------------------------------------------------------------------------
+// With --frames N, stdout carries only this JSON so it can be piped to a
+// gate; reports and raylib's log go to stderr
+void WriteRunSummaryJson(FILE *file, long frames, const FrameStats *frameCpu) {
+    fprintf(file, "{\"frames\": %ld, ", frames);
+    if (frameCpu != NULL) { // NULL headless, where there is no render thread
+        WriteFrameStatsJson(file, "frame_cpu", frameCpu);
+        fprintf(file, ", ");
     }
+    WriteFrameStatsJson(file, "sim_tick_cpu", &tickStats);
+    fprintf(file, "}\n");
+}
+
+static void LogToStderr(int logLevel, const char *text, va_list args) {
+    static const char *levelNames[] = { "ALL", "TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL", "NONE" };
+    fprintf(stderr, "%s: ", logLevel >= LOG_ALL && logLevel <= LOG_NONE ? levelNames[logLevel] : "LOG");
+    vfprintf(stderr, text, args);
+    fputc('\n', stderr);
 }
 
-void DrawStars(void) {
-    // Draw each star as a small circle
-    for (int i = 0; i < MAX_STARS; i++) {
-        DrawCircleV(stars[i].position, stars[i].size, stars[i].color);
+// -----------------------------------------------------------------------------
+// Headless Mode
+// -----------------------------------------------------------------------------
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int RunHeadless(const GameOptions *options) {
+    // Steps the simulation at SIM_DT with scripted or replayed input. No
+    // window, no GL context and no draw calls, so this runs on display-less
+    // boxes, as fast as the CPU allows
+    uint64_t seed = options->seed;
+    const char *wavePath = options->wavePath;
+    long frames = options->frames > 0 ? options->frames : HEADLESS_DEFAULT_FRAMES;
+
+    InputReplay replay;
+    bool replaying = options->replayPath != NULL;
+    if (replaying) {
+        if (!LoadInputReplay(&replay, options->replayPath)) return 1;
+        seed = replay.seed;
+        wavePath = replay.wavePath;
+        if (options->frames <= 0 || options->frames > replay.ticks) frames = replay.ticks;
+    }
+
+    InputRecorder recorder = { 0 };
+    if (options->recordPath != NULL && !BeginInputRecording(&recorder, options->recordPath, seed, wavePath)) return 1;
+
+    Ship player = {
+        .speed = 300.0f,
+        .scale = 3.0f
+    };
+    InitSimulation(&player, seed, wavePath);
+
+    long peakBullets = 0;
+    long peakEnemies = 0;
+    long peakParticles = 0;
+    long peakEntities = 0;
+    long hits = 0;
+    InitFrameStats(&tickStats, SIM_DT * 1000.0);
+    double start = NowSeconds();
+    for (long frame = 0; frame < frames; frame++) {
+        PlayerInput input;
+        if (!replaying) {
+            input = ScriptedPlayerInput(frame);
+        } else if (!NextReplayInput(&replay, &input)) {
+            frames = frame;
+            break;
+        }
+        RecordInput(&recorder, input);
+
+        uint64_t cpuStart = ThreadCpuNowNs();
+        hits += StepSimulation(&player, input);
+        RecordFrameTime(&tickStats, ThreadCpuNowNs() - cpuStart);
+
+        int active = CountActiveBullets();
+        if (active > peakBullets) peakBullets = active;
+        active = CountActiveEnemies();
+        if (active > peakEnemies) peakEnemies = active;
+        active = CountActiveParticles();
+        if (active > peakParticles) peakParticles = active;
+        active = world.entityCount;
+        if (active > peakEntities) peakEntities = active;
     }
+    double elapsed = NowSeconds() - start;
+
+    EndInputRecording(&recorder);
+    if (replaying) UnloadInputReplay(&replay);
+
+    fprintf(stderr, "headless: %ld frames in %.3f s (%.0f frames/s, %.1f ns/frame), %d workers%s\n",
+           frames, elapsed, elapsed > 0.0 ? frames / elapsed : 0.0,
+           frames > 0 ? elapsed * 1e9 / frames : 0.0, GetJobWorkerCount(), replaying ? ", replayed input" : "");
+    // Zero with workers running means every update stayed on this thread
+    fprintf(stderr, "headless: %llu updates split across the workers\n", GetJobDispatchCount());
+    fprintf(stderr, "headless: peak enemies %ld, %ld bullet hits, peak particles %ld\n", peakEnemies, hits, peakParticles);
+    fprintf(stderr, "headless: peak bullets %ld, player at (%.1f, %.1f), star checksum %08x\n",
+           peakBullets, player.position.x, player.position.y, (unsigned)StarFieldChecksum());
+    fprintf(stderr, "headless: peak entities %ld, %d pickups collected, %d enemies hit the ship\n", peakEntities,
+            player.pickups, player.collisions);
+    FrameStatsSummary ticks = SummarizeFrameStats(&tickStats);
+    fprintf(stderr, "headless: tick cpu p50 %.3f, p95 %.3f, p99 %.3f, max %.3f ms, %llu over %.2f ms\n",
+           ticks.p50Ms, ticks.p95Ms, ticks.p99Ms, ticks.maxMs, (unsigned long long)ticks.budgetMisses,
+           SIM_DT * 1000.0);
+#ifdef ARENA_DEBUG
+    WriteArenaReport(stderr);
+#endif
+    if (options->frames > 0) WriteRunSummaryJson(stdout, frames, NULL);
+
+    return 0;
 }
 
 // -----------------------------------------------------------------------------
 // Main
 // -----------------------------------------------------------------------------
-int main(void)
+int main(int argc, char **argv)
 {
+    GameOptions options = {
+        .seed = 1,
+        .wavePath = DEFAULT_WAVE_SCRIPT,
+        .threads = JOB_WORKERS_AUTO
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (strcmp(argv[i], "--render-check") == 0) {
+            options.renderCheck = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            options.frames = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = strtoull(argv[++i], NULL, 10);
+            options.seeded = true;
+        } else if (strcmp(argv[i], "--waves") == 0 && i + 1 < argc) {
+            options.wavePath = argv[++i];
+        } else if (strcmp(argv[i], "--profile-csv") == 0 && i + 1 < argc) {
+            options.profileCsvPath = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            options.replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = (int)strtol(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--headless] [--frames N] [--seed N] [--waves FILE] [--render-check]\n"
+                            "       [--profile-csv FILE] [--record FILE] [--replay FILE] [--threads N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetTraceLogCallback(LogToStderr);
+    if (options.renderCheck) return RunRenderCheck();
+
+    // Results do not depend on the worker count, so --threads 0 (serial)
+    // and the default reproduce the same run
+    InitJobSystem(options.threads);
+    if (options.headless) {
+        int status = RunHeadless(&options);
+        ShutdownJobSystem();
+        return status;
+    }
+
+    // Fresh field each launch unless --seed is given; a replay brings its own
+    uint64_t seed = options.seeded ? options.seed : (uint64_t)time(NULL);
+    const char *wavePath = options.wavePath;
+
+    InputReplay replay;
+    bool replaying = options.replayPath != NULL;
+    if (replaying) {
+        if (!LoadInputReplay(&replay, options.replayPath)) return 1;
+        seed = replay.seed;
+        wavePath = replay.wavePath;
+    }
+
+    InputRecorder recorder = { 0 };
+    if (options.recordPath != NULL && !BeginInputRecording(&recorder, options.recordPath, seed, wavePath)) return 1;
+
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib shmup test");
     SetTargetFPS(60);
 
-    Texture2D ship_sprite = LoadTexture("assets/raw/ship_sheet.png");
-
     Ship player = {
-        .position = { SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f },
-        .texture = ship_sprite,
         .speed = 300.0f,
         .velocity = { 0 }, // This field seems unused in your current code.
         .scale = 3.0f // <--- INCREASE THIS VALUE TO MAKE THE SHIP BIGGER
     };
 
-    // Define the source rectangles for each frame on the sprite sheet
-    // Your sprite sheet is 120x24 px, with 5 frames of 24x24 px
-    // Frame 1: x=0, y=0, width=24, height=24
-    // Frame 2: x=24, y=0, width=24, height=24
-    // Frame 3: x=48, y=0, width=24, height=24
-    // Frame 4: x=72, y=0, width=24, height=24
-    // Frame 5: x=96, y=0, width=24, height=24
-
-    Rectangle frame1 = { 0.0f, 0.0f, 24.0f, 24.0f };
-    Rectangle frame2 = { 24.0f, 0.0f, 24.0f, 24.0f };
-    Rectangle frame3 = { 48.0f, 0.0f, 24.0f, 24.0f }; // Default frame
-    Rectangle frame4 = { 72.0f, 0.0f, 24.0f, 24.0f };
-    Rectangle frame5 = { 96.0f, 0.0f, 24.0f, 24.0f };
-
-    Rectangle currentFrame = frame3; // Start with the third frame
+    bool showProfiler = true; // F3 toggles the phase timing overlay
+    bool bakedStars = true;   // F4 switches to drawing every star, for comparison
+
+    // Pixels are only needed until the atlas is on the GPU. Without a bundle
+    // (make bundle) the atlas decodes the raw PNGs instead.
+    LoadAssetBundle(&assetBundle, ResolveAssetPath(BUNDLE_DEFAULT_PATH));
+    InitAtlas();
+    UnloadAssetBundle(&assetBundle);
+    InitSimulation(&player, seed, wavePath); // After the atlas, so animations resolve real rectangles
+    BakeStarTiles();                         // Needs the atlas and the star pattern
+    InitProfiler();
+
+    // The simulation runs on its own thread from here on; this thread only
+    // reads input and draws snapshots. Tick 0 is published up front so
+    // there is always something to draw.
+    InitSnapshotBuffer(&snapshots);
+    InitFrameStats(&frameStats, FRAME_BUDGET_MS);
+    InitFrameStats(&tickStats, SIM_DT * 1000.0);
+    PublishSimulation(&snapshots, &player, 0);
+    SimulationThread sim = {
+        .player = &player,
+        .replay = replaying ? &replay : NULL,
+        .recorder = &recorder,
+        .snapshots = &snapshots
+    };
+    pthread_t simThread;
+    if (pthread_create(&simThread, NULL, SimulationThreadMain, &sim) != 0) {
+        fprintf(stderr, "cannot start the simulation thread\n");
+        CloseWindow();
+        return 1;
+    }
 
-    InitBullets();
-    InitStars();
+    // Render-thread temporaries live in the frame arena, so a frame's
+    // leftovers are dropped at the top of the next
+    UseScratchArena(&frameArena);
 
-    while (!WindowShouldClose())
+    long frame = 0;
+    while (!WindowShouldClose() && !__atomic_load_n(&sim.finished, __ATOMIC_ACQUIRE) &&
+           (options.frames <= 0 || frame < options.frames))
     {
-        float deltaTime = GetFrameTime();
-
-        // Player Movement and Frame Selection
-        bool movingLeft = false;
-        bool movingRight = false;
-
-        if (IsKeyDown(KEY_RIGHT)) {
-            player.position.x += player.speed * deltaTime;
-            movingRight = true;
-        }
-        if (IsKeyDown(KEY_LEFT)) {
-            player.position.x -= player.speed * deltaTime;
-            movingLeft = true;
-        }
-        if (IsKeyDown(KEY_DOWN))  player.position.y += player.speed * deltaTime;
-        if (IsKeyDown(KEY_UP))    player.position.y -= player.speed * deltaTime;
-
-        // Determine current animation frame based on maintained key press
-        if (movingRight) {
-            currentFrame = frame5; // Remain on frame 5 when moving right
-        } else if (movingLeft) {
-            currentFrame = frame1; // Remain on frame 1 when moving left
-        } else {
-            currentFrame = frame3; // Default (idle) frame
-        }
-
-        timeSinceLastShot += deltaTime;
-        // Shooting
-        if (IsKeyDown(KEY_SPACE) && timeSinceLastShot >= shootCooldown) {
-            // Adjust bullet spawn position based on the scaled ship size
-            Vector2 bulletSpawnPos = {
-                player.position.x + (currentFrame.width * player.scale / 2.0f), // Center horizontally
-                player.position.y                                               // At the ship's Y position
-            };
-            // Move the bullet slightly above the ship (relative to scaled height)
-            bulletSpawnPos.y -= (currentFrame.height * player.scale / 5.0f); // Adjust as needed for bullet to appear at ship's nose
-
-            ShootBullet(bulletSpawnPos); // Fire the bullet
-            timeSinceLastShot = 0.0f; // Reset cooldown timer
-        }
-
-        // Update
-        UpdateBullets(deltaTime);
-        UpdateStars(deltaTime); 
+        ResetArena(&frameArena);
+
+        // Thread CPU time, so the frame limiter's sleep is not a cost
+        uint64_t frameCpuStart = ThreadCpuNowNs();
+
+        ProfileBegin(PROFILE_INPUT);
+        __atomic_store_n(&sim.input, PackPlayerInput(ReadPlayerInput()), __ATOMIC_RELAXED);
+        if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;
+        if (IsKeyPressed(KEY_F4)) bakedStars = !bakedStars;
+        ProfileEnd(PROFILE_INPUT);
+
+        // How far between the snapshot's tick and the one before it this
+        // frame is rendered, from how long ago the snapshot was published
+        const SimSnapshot *snapshot = AcquireSnapshot(&snapshots);
+        float alpha = (float)((ProfileNowNs() - snapshot->publishedNs) / 1e9 / SIM_DT);
+        if (alpha > 1.0f) alpha = 1.0f;
+        Vector2 shipPosition = {
+            snapshot->shipPreviousPosition.x + (snapshot->shipPosition.x - snapshot->shipPreviousPosition.x) * alpha,
+            snapshot->shipPreviousPosition.y + (snapshot->shipPosition.y - snapshot->shipPreviousPosition.y) * alpha
+        };
 
         // Draw
+        ProfileBegin(PROFILE_DRAW);
         BeginDrawing();
         ClearBackground(BLACK);
 
-        DrawStars();
+        if (bakedStars) {
+            DrawStarsBaked(snapshot->starLayers, alpha);
+        } else {
+            DrawStars(snapshot->starLayers, alpha);
+        }
+        DrawParticles(&snapshot->particles, alpha);
+        DrawEnemies(&snapshot->enemies, alpha);
+        DrawEntitySprites(&snapshot->entities, alpha);
         
         // Use DrawTexturePro to draw with scaling
-        // sourceRect: The part of the texture to draw (your currentFrame)
+        // sourceRect: The part of the atlas to draw (the ship's current frame)
         // destRect: Where and how big to draw it on the screen
-        //            x, y are player.position
-        //            width, height are currentFrame's dimensions * player.scale
+        //            x, y are the interpolated ship position
+        //            width, height are the frame's dimensions * the ship's scale
         // origin: The point in destRect that corresponds to player.position
-        //         (0,0) means top-left of the scaled image is at player.position
+        //         (0,0) means top-left of the scaled image is at the ship position
         // rotation: 0.0f for no rotation
         // tint: WHITE for no tint
-        DrawTexturePro(player.texture,
-                       currentFrame,
-                       (Rectangle){ player.position.x, player.position.y,
-                                    currentFrame.width * player.scale, currentFrame.height * player.scale },
+        Rectangle shipFrame = snapshot->shipSource;
+        DrawTexturePro(atlas.texture,
+                       shipFrame,
+                       (Rectangle){ shipPosition.x, shipPosition.y,
+                                    shipFrame.width * snapshot->shipScale, shipFrame.height * snapshot->shipScale },
                        (Vector2){ 0, 0 }, // Origin for rotation/scaling, set to (0,0) for top-left
                        0.0f,
                        WHITE);
-        DrawBullets();
+        DrawBullets(&snapshot->bullets, alpha);
 
         DrawFPS(10, 10);
+        if (showProfiler) {
+            DrawProfilerOverlay(10, 34);
+            DrawFrameStatsOverlay(&frameStats, 10, 34 + 12 * (PROFILE_PHASE_COUNT + 1) + 12);
+        }
+        ProfileEnd(PROFILE_DRAW);
 
+        ProfileBegin(PROFILE_SWAP);
         EndDrawing();
+        ProfileEnd(PROFILE_SWAP);
+
+        ProfileFrameEnd();
+        RecordFrameTime(&frameStats, ThreadCpuNowNs() - frameCpuStart);
+        frame++;
     }
 
-    UnloadTexture(ship_sprite);
+    __atomic_store_n(&sim.quit, 1, __ATOMIC_RELEASE);
+    pthread_join(simThread, NULL);
+
+    // Machine-readable summary for gating on tail latency
+    if (options.frames > 0) WriteRunSummaryJson(stdout, frame, &frameStats);
+#ifdef ARENA_DEBUG
+    WriteArenaReport(stderr);
+#endif
+
+    if (options.profileCsvPath != NULL) WriteProfileCsv(options.profileCsvPath);
+    EndInputRecording(&recorder);
+    if (replaying) UnloadInputReplay(&replay);
+
+    UnloadStarTiles();
+    UnloadAtlas();
     CloseWindow();
+    ShutdownJobSystem();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,82 @@
+#include "animation.h"
+
+#include <math.h>
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+AnimationPool animations;
+
+const AnimationClip animationClips[ANIM_CLIP_COUNT] = {
+    [ANIM_CLIP_SHIP_BANK] = { SPRITE_SHIP_LEFT, 5, 0.0f, ANIM_BLEND },
+    [ANIM_CLIP_ENEMY]     = { SPRITE_ENEMY, 1, 1.0f, ANIM_LOOP },
+};
+
+// -----------------------------------------------------------------------------
+// Animation Functions
+// -----------------------------------------------------------------------------
+void InitAnimations(void) {
+    animations.count = 0;
+}
+
+int CreateAnimation(AnimationClipId clip) {
+    if (animations.count >= MAX_ANIMATIONS) return -1;
+
+    int i = animations.count++;
+    animations.blend[i] = 0.0f;
+    animations.blendTarget[i] = 0.0f;
+    PlayAnimation(i, clip);
+    return i;
+}
+
+void PlayAnimation(int animation, AnimationClipId clip) {
+    animations.clip[animation] = (unsigned char)clip;
+    animations.time[animation] = 0.0f;
+    // Resolve the first frame now so it is valid before the next update
+    animations.frame[animation] = animationClips[clip].first;
+    animations.source[animation] = atlas.frames[animationClips[clip].first];
+}
+
+void SetAnimationBlend(int animation, float target) {
+    animations.blendTarget[animation] = target < -1.0f ? -1.0f : (target > 1.0f ? 1.0f : target);
+}
+
+static int ClipFrame(const AnimationClip *clip, float time, float blend) {
+    switch (clip->mode) {
+        case ANIM_BLEND:
+            // Map [-1, 1] onto the frames; rounding gives the half frames
+            // an even share of the travel between idle and full bank
+            return (int)lroundf((blend + 1.0f) * 0.5f * (clip->frameCount - 1));
+        case ANIM_ONCE: {
+            int frame = (int)(time / clip->frameTime);
+            return frame < clip->frameCount ? frame : clip->frameCount - 1;
+        }
+        default:
+            return (int)(time / clip->frameTime) % clip->frameCount;
+    }
+}
+
+void UpdateAnimations(float deltaTime) {
+    // One pass over every slot: advance time, ease the blend toward its
+    // target, pick the frame and look up its atlas rectangle
+    float step = ANIM_BANK_RATE * deltaTime;
+    for (int i = 0; i < animations.count; i++) {
+        const AnimationClip *clip = &animationClips[animations.clip[i]];
+
+        float time = animations.time[i] + deltaTime;
+        float loopLength = clip->frameTime * clip->frameCount;
+        if (clip->mode == ANIM_LOOP && time >= loopLength) time -= loopLength; // Stay small and precise
+        animations.time[i] = time;
+
+        float delta = animations.blendTarget[i] - animations.blend[i];
+        animations.blend[i] += delta > step ? step : (delta < -step ? -step : delta);
+
+        SpriteId frame = (SpriteId)(clip->first + ClipFrame(clip, time, animations.blend[i]));
+        animations.frame[i] = frame;
+        animations.source[i] = atlas.frames[frame];
+    }
+}
+
+SpriteId GetAnimationFrame(int animation) {
+    return animations.frame[animation];
+}
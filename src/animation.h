@@ -0,0 +1,66 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "raylib.h"
+#include "atlas.h"
+
+#ifndef MAX_ANIMATIONS
+#define MAX_ANIMATIONS 1024 // Pool capacity, override with -DMAX_ANIMATIONS=N
+#endif
+#define ANIM_BANK_RATE 6.0f // Blend units per second; full bank from idle in 1/6 s
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef enum AnimationMode {
+    ANIM_LOOP = 0,  // Frames advance with time and wrap
+    ANIM_ONCE,      // Frames advance with time and hold the last one
+    ANIM_BLEND      // Frame picked by a blend value in [-1, 1] that eases
+                    // toward its target, e.g. banking through the half frames
+} AnimationMode;
+
+// Frames of a clip are consecutive SpriteIds starting at first
+typedef struct AnimationClip {
+    SpriteId first;
+    int frameCount;
+    float frameTime; // Seconds per frame, timed modes only
+    AnimationMode mode;
+} AnimationClip;
+
+typedef enum AnimationClipId {
+    ANIM_CLIP_SHIP_BANK = 0,    // Full left .. idle .. full right
+    ANIM_CLIP_ENEMY,
+    ANIM_CLIP_COUNT
+} AnimationClipId;
+
+// Structure-of-arrays animation state, one slot per animated entity.
+// UpdateAnimations advances every slot and writes frame[] and the matching
+// atlas source rectangles into source[], contiguous and ready for drawing.
+typedef struct AnimationPool {
+    unsigned char clip[MAX_ANIMATIONS];
+    float time[MAX_ANIMATIONS];        // Seconds into the clip
+    float blend[MAX_ANIMATIONS];
+    float blendTarget[MAX_ANIMATIONS];
+    SpriteId frame[MAX_ANIMATIONS];
+    Rectangle source[MAX_ANIMATIONS];
+    int count;
+} AnimationPool;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern AnimationPool animations;
+extern const AnimationClip animationClips[ANIM_CLIP_COUNT];
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitAnimations(void);
+// Returns the slot, or -1 when the pool is full
+int CreateAnimation(AnimationClipId clip);
+void PlayAnimation(int animation, AnimationClipId clip);
+void SetAnimationBlend(int animation, float target);
+void UpdateAnimations(float deltaTime);
+SpriteId GetAnimationFrame(int animation);
+
+#endif // ANIMATION_H
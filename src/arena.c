@@ -0,0 +1,104 @@
+#include "arena.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+static unsigned char frameMemory[FRAME_ARENA_SIZE] __attribute__((aligned(ARENA_ALIGNMENT)));
+Arena frameArena = { frameMemory, FRAME_ARENA_SIZE, 0, 0, 0, "frame" };
+
+// Pages of an unclaimed arena are never touched, so the pool costs address
+// space rather than memory
+static unsigned char scratchMemory[SCRATCH_ARENA_COUNT][SCRATCH_ARENA_SIZE] __attribute__((aligned(ARENA_ALIGNMENT)));
+static Arena scratchArenas[SCRATCH_ARENA_COUNT];
+static int scratchClaimed = 0;
+
+static __thread Arena *threadScratch = NULL;
+static __thread bool threadScratchClaimed = false; // Set even when the pool ran out
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static void ReleaseTo(Arena *arena, size_t used) {
+#ifdef ARENA_DEBUG
+    // Anything still reading released memory sees garbage, not stale data
+    memset(arena->base + used, ARENA_POISON, arena->used - used);
+#endif
+    arena->used = used;
+}
+
+static Arena *ThreadScratchArena(void) {
+    if (threadScratchClaimed) return threadScratch;
+    threadScratchClaimed = true;
+
+    int slot = __atomic_fetch_add(&scratchClaimed, 1, __ATOMIC_RELAXED);
+    if (slot >= SCRATCH_ARENA_COUNT) {
+        // More threads than the pool was sized for. Reported once; this
+        // thread's pushes fail and callers take their fallback paths.
+        fprintf(stderr, "arena: no scratch arena left for this thread\n");
+        return NULL;
+    }
+    Arena *arena = &scratchArenas[slot];
+    *arena = (Arena){ scratchMemory[slot], SCRATCH_ARENA_SIZE, 0, 0, 0, "scratch" };
+    threadScratch = arena;
+    return arena;
+}
+
+static void ReportArena(FILE *out, const Arena *arena, int index) {
+    char name[32];
+    snprintf(name, sizeof(name), index < 0 ? "%s" : "%s %d", arena->name, index);
+    fprintf(out, "arena %-10s high water %8.1f KB of %8.1f KB, %d overflows\n", name,
+            arena->highWater / 1024.0, arena->size / 1024.0, arena->overflows);
+}
+
+// -----------------------------------------------------------------------------
+// Arena Functions
+// -----------------------------------------------------------------------------
+void *ArenaPush(Arena *arena, size_t size) {
+    if (arena == NULL) return NULL;
+    size_t start = (arena->used + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (start > arena->size || size > arena->size - start) {
+        arena->overflows++;
+#ifdef ARENA_DEBUG
+        fprintf(stderr, "arena %s: %zu bytes do not fit, %zu of %zu in use\n", arena->name, size, arena->used,
+                arena->size);
+#endif
+        return NULL;
+    }
+    arena->used = start + size;
+    if (arena->used > arena->highWater) arena->highWater = arena->used;
+    return arena->base + start;
+}
+
+void ResetArena(Arena *arena) {
+    ReleaseTo(arena, 0);
+}
+
+Scratch BeginScratch(void) {
+    Arena *arena = ThreadScratchArena();
+    return (Scratch){ arena, arena != NULL ? arena->used : 0 };
+}
+
+void EndScratch(Scratch scratch) {
+    if (scratch.arena != NULL) ReleaseTo(scratch.arena, scratch.used);
+}
+
+void UseScratchArena(Arena *arena) {
+    threadScratch = arena;
+    threadScratchClaimed = true;
+}
+
+void ResetScratch(void) {
+    Arena *arena = ThreadScratchArena();
+    if (arena != NULL) ResetArena(arena);
+}
+
+void WriteArenaReport(FILE *out) {
+    ReportArena(out, &frameArena, -1);
+    int claimed = __atomic_load_n(&scratchClaimed, __ATOMIC_RELAXED);
+    for (int i = 0; i < claimed && i < SCRATCH_ARENA_COUNT; i++) {
+        ReportArena(out, &scratchArenas[i], i);
+    }
+}
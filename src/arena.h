@@ -0,0 +1,80 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "jobs.h"
+
+// -----------------------------------------------------------------------------
+// Bump arenas for transient data
+// -----------------------------------------------------------------------------
+// An arena hands out memory by bumping an offset into one fixed block and
+// takes it all back at once, so per-frame and per-tick temporaries never
+// touch the heap. Every block is static; nothing here calls malloc.
+//
+// Temporaries go through the scratch API: BeginScratch marks the calling
+// thread's scratch arena, pushes go on top, EndScratch rolls back to the
+// mark. Scopes nest like the stack. The render thread's scratch arena is
+// frameArena, reset at the top of every frame; the simulation thread and
+// each job worker claim one of the pooled scratch arenas on first use, and
+// the simulation resets its own every tick.
+//
+// Build with -DARENA_DEBUG (make debug) to fill released memory with
+// ARENA_POISON, warn on overflow and report every arena's high-water mark
+// at exit.
+
+#ifndef FRAME_ARENA_SIZE
+#define FRAME_ARENA_SIZE (1 << 20)
+#endif
+#ifndef SCRATCH_ARENA_SIZE
+#define SCRATCH_ARENA_SIZE (1 << 20) // Per thread, override with -DSCRATCH_ARENA_SIZE=N
+#endif
+#define SCRATCH_ARENA_COUNT (JOB_MAX_WORKERS + 2) // Workers, the simulation thread and a spare
+#define ARENA_ALIGNMENT 16
+#define ARENA_POISON 0xDD
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct Arena {
+    unsigned char *base;
+    size_t size;
+    size_t used;
+    size_t highWater;   // Most ever in use at once
+    int overflows;      // Pushes that did not fit
+    const char *name;
+} Arena;
+
+// Where a scratch scope started; EndScratch rolls the arena back to it
+typedef struct Scratch {
+    Arena *arena;
+    size_t used;
+} Scratch;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern Arena frameArena;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+// Uninitialized, ARENA_ALIGNMENT-aligned memory, or NULL when the arena is
+// full (or NULL itself, as a scratch arena is once the pool runs out)
+void *ArenaPush(Arena *arena, size_t size);
+#define ArenaPushArray(arena, type, count) ((type *)ArenaPush((arena), sizeof(type) * (size_t)(count)))
+void ResetArena(Arena *arena);
+
+Scratch BeginScratch(void);
+void EndScratch(Scratch scratch);
+// Make arena the calling thread's scratch arena instead of a pooled one
+void UseScratchArena(Arena *arena);
+// Drop everything on the calling thread's scratch arena. Only at the top of
+// a frame or tick, with no scratch scope open.
+void ResetScratch(void);
+
+// One line per arena in use: high-water mark, size and overflows
+void WriteArenaReport(FILE *out);
+
+#endif // ARENA_H
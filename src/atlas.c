@@ -0,0 +1,130 @@
+#include "atlas.h"
+
+#include <stdio.h>
+
+#include "bullets.h"
+#include "bundle.h"
+#include "enemies.h"
+#include "particles.h"
+#include "pickups.h"
+#include "stars.h"
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+// Where a sprite's pixels come from before packing
+typedef struct SpriteSource {
+    Rectangle sheetRect; // Region of the ship sheet, when radius is 0
+    int radius;          // Rasterized white circle of this radius otherwise
+} SpriteSource;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+Atlas atlas;
+
+// The ship sheet is 120x24 px, with 5 frames of 24x24 px
+static const SpriteSource spriteSources[SPRITE_COUNT] = {
+    [SPRITE_SHIP_LEFT]       = { { 0.0f, 0.0f, 24.0f, 24.0f }, 0 },
+    [SPRITE_SHIP_LEFT_HALF]  = { { 24.0f, 0.0f, 24.0f, 24.0f }, 0 },
+    [SPRITE_SHIP_IDLE]       = { { 48.0f, 0.0f, 24.0f, 24.0f }, 0 },
+    [SPRITE_SHIP_RIGHT_HALF] = { { 72.0f, 0.0f, 24.0f, 24.0f }, 0 },
+    [SPRITE_SHIP_RIGHT]      = { { 96.0f, 0.0f, 24.0f, 24.0f }, 0 },
+    [SPRITE_BULLET]          = { { 0 }, BULLET_RADIUS },
+    [SPRITE_STAR_SMALL]      = { { 0 }, STAR_MIN_SIZE },
+    [SPRITE_STAR_MEDIUM]     = { { 0 }, STAR_MIN_SIZE + 1 },
+    [SPRITE_STAR_LARGE]      = { { 0 }, STAR_MIN_SIZE + 2 },
+    [SPRITE_ENEMY]           = { { 0 }, ENEMY_RADIUS },
+    [SPRITE_PARTICLE]        = { { 0 }, PARTICLE_RADIUS },
+    [SPRITE_PICKUP]          = { { 0 }, PICKUP_RADIUS },
+};
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static Image BakeCircleImage(int radius) {
+    // Rasterize with the same primitive the reference draw paths use. The
+    // cell is the diameter plus a 1 px border for the edge fringe.
+    int size = radius * 2 + 2;
+    RenderTexture2D target = LoadRenderTexture(size, size);
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    DrawCircleV((Vector2){ size / 2.0f, size / 2.0f }, (float)radius, WHITE);
+    EndTextureMode();
+
+    Image image = LoadImageFromTexture(target.texture);
+    ImageFlipVertical(&image); // Render textures are stored bottom-up
+    UnloadRenderTexture(target);
+    return image;
+}
+
+Vector2 GetSpriteSize(SpriteId sprite) {
+    const SpriteSource *source = &spriteSources[sprite];
+    if (source->radius > 0) {
+        float size = (float)(source->radius * 2 + 2);
+        return (Vector2){ size, size };
+    }
+    return (Vector2){ source->sheetRect.width, source->sheetRect.height };
+}
+
+// -----------------------------------------------------------------------------
+// Atlas Functions
+// -----------------------------------------------------------------------------
+bool InitAtlas(void) {
+    // Bundled pixels live in the mapping and are already RGBA8; only the PNG
+    // fallback owns (and must free) its image
+    Image sheet = { 0 };
+    bool sheetOwned = false;
+    bool sheetLoaded = GetBundleImage(&assetBundle, ATLAS_SHIP_SHEET_ASSET, &sheet);
+    if (!sheetLoaded) {
+        sheet = LoadImage(ResolveAssetPath(ATLAS_SHIP_SHEET));
+        sheetLoaded = sheetOwned = IsImageValid(sheet);
+        if (!sheetLoaded) fprintf(stderr, "atlas: cannot load %s\n", ATLAS_SHIP_SHEET);
+    }
+
+    // Shelf packing in id order: sprites fill a row left to right and a new
+    // row starts below the tallest sprite of the previous one. The sprite
+    // set is small and known, so this is already tight enough.
+    int x = ATLAS_PADDING;
+    int y = ATLAS_PADDING;
+    int rowHeight = 0;
+    for (int s = 0; s < SPRITE_COUNT; s++) {
+        Vector2 size = GetSpriteSize((SpriteId)s);
+        if (x + (int)size.x + ATLAS_PADDING > ATLAS_WIDTH) {
+            x = ATLAS_PADDING;
+            y += rowHeight + ATLAS_PADDING;
+            rowHeight = 0;
+        }
+        atlas.frames[s] = (Rectangle){ (float)x, (float)y, size.x, size.y };
+        x += (int)size.x + ATLAS_PADDING;
+        if ((int)size.y > rowHeight) rowHeight = (int)size.y;
+    }
+
+    int height = 1;
+    while (height < y + rowHeight + ATLAS_PADDING) height *= 2;
+
+    Image image = GenImageColor(ATLAS_WIDTH, height, BLANK);
+    for (int s = 0; s < SPRITE_COUNT; s++) {
+        const SpriteSource *source = &spriteSources[s];
+        if (source->radius > 0) {
+            Image circle = BakeCircleImage(source->radius);
+            ImageDraw(&image, circle, (Rectangle){ 0, 0, (float)circle.width, (float)circle.height }, atlas.frames[s], WHITE);
+            UnloadImage(circle);
+        } else if (sheetLoaded) {
+            ImageDraw(&image, sheet, source->sheetRect, atlas.frames[s], WHITE);
+        }
+    }
+
+    atlas.texture = LoadTextureFromImage(image);
+    atlas.loaded = true;
+
+    UnloadImage(image);
+    if (sheetOwned) UnloadImage(sheet);
+    return sheetLoaded;
+}
+
+void UnloadAtlas(void) {
+    if (!atlas.loaded) return;
+    UnloadTexture(atlas.texture);
+    atlas.loaded = false;
+}
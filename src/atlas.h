@@ -0,0 +1,62 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "raylib.h"
+
+// -----------------------------------------------------------------------------
+// Sprite atlas
+// -----------------------------------------------------------------------------
+// Every sprite in the game is packed into one texture when the window opens:
+// the ship frames cut from the sheet and the circles for bullets, stars and
+// enemies, which are rasterized at load time. The sheet comes from the mapped
+// asset bundle when one is loaded and from the PNG otherwise. Draw code looks up the source
+// rectangle in atlas.frames, so every sprite draw binds the same texture and
+// raylib keeps the whole scene in as few batches as its buffer allows.
+
+#define ATLAS_SHIP_SHEET "assets/raw/ship_sheet.png"
+#define ATLAS_SHIP_SHEET_ASSET "ship_sheet" // Bundle entry, preferred when a bundle is loaded
+#define ATLAS_WIDTH 256 // Height grows to fit, in powers of two
+#define ATLAS_PADDING 1 // Empty pixels around each sprite against bleeding
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef enum SpriteId {
+    SPRITE_SHIP_LEFT = 0,       // Frame 1 on the sheet, full bank left
+    SPRITE_SHIP_LEFT_HALF,      // Frame 2
+    SPRITE_SHIP_IDLE,           // Frame 3
+    SPRITE_SHIP_RIGHT_HALF,     // Frame 4
+    SPRITE_SHIP_RIGHT,          // Frame 5, full bank right
+    SPRITE_BULLET,
+    SPRITE_STAR_SMALL,          // Stars are size-bucketed by radius 1..3
+    SPRITE_STAR_MEDIUM,
+    SPRITE_STAR_LARGE,
+    SPRITE_ENEMY,
+    SPRITE_PARTICLE,            // White, tinted and scaled per particle
+    SPRITE_PICKUP,
+    SPRITE_COUNT
+} SpriteId;
+
+typedef struct Atlas {
+    Texture2D texture;
+    Rectangle frames[SPRITE_COUNT]; // Source rectangles in texture, generated by InitAtlas
+    bool loaded;
+} Atlas;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern Atlas atlas;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+// Load the source images, pack them and upload the texture. Needs a GL
+// context, so call it after InitWindow(). Returns false if the ship sheet
+// is missing; the circle sprites are still packed.
+bool InitAtlas(void);
+void UnloadAtlas(void);
+// Size of a sprite in pixels, available without a GL context
+Vector2 GetSpriteSize(SpriteId sprite);
+
+#endif // ATLAS_H
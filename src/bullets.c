@@ -0,0 +1,98 @@
+#include "bullets.h"
+#include "kernels.h"
+#include "atlas.h"
+#include "jobs.h"
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+BulletPool bullets;
+
+// -----------------------------------------------------------------------------
+// Bullet Functions
+// -----------------------------------------------------------------------------
+void InitBullets(void) {
+    bullets.count = 0;
+}
+
+void ShootBullet(Vector2 shipPos) {
+    if (bullets.count >= SHIP_MAX_BULLETS) return; // Pool exhausted, drop the shot
+
+    int i = bullets.count++;
+    bullets.x[i] = shipPos.x;
+    bullets.y[i] = shipPos.y;
+    bullets.vx[i] = 0.0f;
+    bullets.vy[i] = -500.0f; // Shoot upward
+}
+
+int ReserveBullets(int count, int *granted) {
+    int first = bullets.count;
+    int available = SHIP_MAX_BULLETS - first;
+    *granted = count < available ? count : available;
+    bullets.count += *granted;
+    return first;
+}
+
+static void IntegrateBulletRange(void *context, int start, int end) {
+    float deltaTime = *(const float *)context;
+    IntegrateBullets(bullets.x + start, bullets.y + start, bullets.vx + start, bullets.vy + start,
+                     bullets.offscreen + start, end - start, deltaTime);
+}
+
+void UpdateBullets(float deltaTime) {
+    // Integration is element-wise and split across the workers; compaction
+    // reorders the pool and stays serial
+    ParallelFor(bullets.count, JOB_GRAIN, IntegrateBulletRange, &deltaTime);
+    RemoveBullets(bullets.offscreen);
+}
+
+void RemoveBullets(const unsigned char *remove) {
+    // Walk backwards so every slot above i is already known to be live;
+    // swap-removing the last bullet into i then never skips one.
+    for (int i = bullets.count - 1; i >= 0; i--) {
+        if (remove[i]) {
+            int last = --bullets.count;
+            bullets.x[i] = bullets.x[last];
+            bullets.y[i] = bullets.y[last];
+            bullets.vx[i] = bullets.vx[last];
+            bullets.vy[i] = bullets.vy[last];
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Bullet Rendering
+// -----------------------------------------------------------------------------
+void DrawBullets(const BulletPool *pool, float alpha) {
+    // Every bullet is one quad of the atlas circle. All quads reference the
+    // atlas texture, so raylib appends them to the current batch and flushes
+    // them in a single draw call (split only when the batch vertex buffer
+    // fills up), instead of one triangle fan per bullet.
+    if (!atlas.loaded) {
+        DrawBulletsReference(pool, alpha);
+        return;
+    }
+
+    // Bullets move linearly, so interpolating between the last two ticks is
+    // stepping back along the velocity; no previous positions are stored
+    float lag = (1.0f - alpha) * SIM_DT;
+    Rectangle frame = atlas.frames[SPRITE_BULLET];
+    float half = frame.width / 2.0f;
+    for (int i = 0; i < pool->count; i++) {
+        Vector2 position = { pool->x[i] - pool->vx[i] * lag - half, pool->y[i] - pool->vy[i] * lag - half };
+        DrawTextureRec(atlas.texture, frame, position, BULLET_COLOR);
+    }
+}
+
+void DrawBulletsReference(const BulletPool *pool, float alpha) {
+    // Original per-bullet circle path, kept as the image reference
+    float lag = (1.0f - alpha) * SIM_DT;
+    for (int i = 0; i < pool->count; i++) {
+        Vector2 position = { pool->x[i] - pool->vx[i] * lag, pool->y[i] - pool->vy[i] * lag };
+        DrawCircleV(position, BULLET_RADIUS, BULLET_COLOR);
+    }
+}
+
+int CountActiveBullets(void) {
+    return bullets.count;
+}
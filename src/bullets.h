@@ -0,0 +1,48 @@
+#ifndef BULLETS_H
+#define BULLETS_H
+
+#include "raylib.h"
+#include "config.h"
+
+#define BULLET_RADIUS 5
+#define BULLET_COLOR RED
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+// Structure-of-arrays bullet pool. Live bullets are packed densely in
+// [0..count). Spawning appends, despawning swaps the last live bullet into
+// the freed slot.
+typedef struct BulletPool {
+    float x[SHIP_MAX_BULLETS];
+    float y[SHIP_MAX_BULLETS];
+    float vx[SHIP_MAX_BULLETS];
+    float vy[SHIP_MAX_BULLETS];
+    unsigned char offscreen[SHIP_MAX_BULLETS]; // Written by the integration kernel
+    int count;
+} BulletPool;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern BulletPool bullets;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitBullets(void);
+void ShootBullet(Vector2 shipPos);
+// Reserve up to count contiguous slots at the end of the pool for the caller
+// to fill; returns the first index and stores how many were granted
+int ReserveBullets(int count, int *granted);
+void UpdateBullets(float deltaTime);
+// Draw from the live pool or a snapshot copy of it (see snapshot.h). alpha
+// in [0, 1] is how far the render time sits between the previous and the
+// current simulation tick
+void DrawBullets(const BulletPool *pool, float alpha);
+void DrawBulletsReference(const BulletPool *pool, float alpha);
+int CountActiveBullets(void);
+// Despawn every bullet i with remove[i] set; remove[0..count) is consumed
+void RemoveBullets(const unsigned char *remove);
+
+#endif // BULLETS_H
@@ -0,0 +1,103 @@
+#define _POSIX_C_SOURCE 200112L // mmap, fstat
+
+#include "bundle.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+AssetBundle assetBundle;
+
+// -----------------------------------------------------------------------------
+// Bundle Functions
+// -----------------------------------------------------------------------------
+static bool ValidateBundle(const AssetBundle *bundle) {
+    if (bundle->size < sizeof(BundleHeader)) return false;
+    if (memcmp(bundle->header->magic, BUNDLE_MAGIC, BUNDLE_MAGIC_SIZE) != 0) return false;
+
+    uint64_t indexEnd = sizeof(BundleHeader) + (uint64_t)bundle->header->entryCount * sizeof(BundleEntry);
+    if (indexEnd > bundle->size) return false;
+
+    for (uint32_t i = 0; i < bundle->header->entryCount; i++) {
+        const BundleEntry *entry = &bundle->entries[i];
+        if (entry->name[BUNDLE_NAME_SIZE - 1] != '\0') return false;
+        if (entry->offset < indexEnd || entry->offset > bundle->size || entry->size > bundle->size - entry->offset) return false;
+        if (entry->size != (uint64_t)GetPixelDataSize((int)entry->width, (int)entry->height, (int)entry->format)) return false;
+    }
+    return true;
+}
+
+bool LoadAssetBundle(AssetBundle *bundle, const char *path) {
+    memset(bundle, 0, sizeof(*bundle));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false; // No bundle is normal in a fresh checkout
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void *base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "bundle: cannot map %s\n", path);
+        return false;
+    }
+
+    bundle->base = base;
+    bundle->size = (size_t)info.st_size;
+    bundle->header = base;
+    bundle->entries = (const BundleEntry *)((const char *)base + sizeof(BundleHeader));
+
+    if (!ValidateBundle(bundle)) {
+        fprintf(stderr, "bundle: %s is corrupt or from another version\n", path);
+        munmap(base, bundle->size);
+        memset(bundle, 0, sizeof(*bundle));
+        return false;
+    }
+
+    bundle->loaded = true;
+    return true;
+}
+
+void UnloadAssetBundle(AssetBundle *bundle) {
+    if (!bundle->loaded) return;
+    munmap(bundle->base, bundle->size);
+    memset(bundle, 0, sizeof(*bundle));
+}
+
+bool GetBundleImage(const AssetBundle *bundle, const char *name, Image *image) {
+    if (!bundle->loaded) return false;
+
+    for (uint32_t i = 0; i < bundle->header->entryCount; i++) {
+        const BundleEntry *entry = &bundle->entries[i];
+        if (strcmp(entry->name, name) != 0) continue;
+
+        *image = (Image){
+            .data = (char *)bundle->base + entry->offset,
+            .width = (int)entry->width,
+            .height = (int)entry->height,
+            .mipmaps = 1,
+            .format = (int)entry->format
+        };
+        return true;
+    }
+    return false;
+}
+
+const char *ResolveAssetPath(const char *relative) {
+    static char path[1024];
+    snprintf(path, sizeof(path), "%s%s", GetApplicationDirectory(), relative);
+    if (FileExists(path)) return path;
+
+    snprintf(path, sizeof(path), "%s", relative);
+    return path;
+}
@@ -0,0 +1,75 @@
+#ifndef BUNDLE_H
+#define BUNDLE_H
+
+#include "raylib.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Precompiled asset bundle
+// -----------------------------------------------------------------------------
+// tools/pack_assets.c decodes assets/raw/*.png offline into one file holding
+// an index and raw RGBA8 pixels. At runtime the file is mmapped and images
+// point straight into the mapping, so startup does no PNG decoding and no
+// copying before the GPU upload, however many assets there are.
+//
+// File layout (native byte order, little endian on every target we ship):
+//     BundleHeader
+//     BundleEntry[entryCount]
+//     pixel data, each blob aligned to BUNDLE_ALIGNMENT
+
+#define BUNDLE_MAGIC "SHMUPBD1"
+#define BUNDLE_MAGIC_SIZE 8
+#define BUNDLE_NAME_SIZE 48
+#define BUNDLE_ALIGNMENT 16
+#define BUNDLE_DEFAULT_PATH "assets/shmup.bundle"
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct BundleHeader {
+    char magic[BUNDLE_MAGIC_SIZE];
+    uint32_t entryCount;
+    uint32_t reserved;
+} BundleHeader;
+
+typedef struct BundleEntry {
+    char name[BUNDLE_NAME_SIZE]; // Source file name without extension, NUL terminated
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;             // raylib PixelFormat, always UNCOMPRESSED_R8G8B8A8 today
+    uint32_t reserved;
+    uint64_t offset;             // From the start of the file
+    uint64_t size;
+} BundleEntry;
+
+typedef struct AssetBundle {
+    void *base;                  // Start of the mapping
+    size_t size;
+    const BundleHeader *header;
+    const BundleEntry *entries;
+    bool loaded;
+} AssetBundle;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern AssetBundle assetBundle;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+// Map a bundle read-only and validate its index. Returns false (and leaves
+// the bundle unloaded) when the file is missing or malformed.
+bool LoadAssetBundle(AssetBundle *bundle, const char *path);
+void UnloadAssetBundle(AssetBundle *bundle);
+// Describe a bundled image without copying it. The image data points into
+// the mapping: never UnloadImage it, and don't use it past UnloadAssetBundle.
+bool GetBundleImage(const AssetBundle *bundle, const char *name, Image *image);
+
+// Path of an asset relative to the executable's directory when it exists
+// there, otherwise the path as given (relative to the working directory).
+// Returns a static buffer that the next call overwrites.
+const char *ResolveAssetPath(const char *relative);
+
+#endif // BUNDLE_H
@@ -0,0 +1,20 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// -----------------------------------------------------------------------------
+// Constants shared by every module
+// -----------------------------------------------------------------------------
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 600
+#ifndef SHIP_MAX_BULLETS
+#define SHIP_MAX_BULLETS 4096 // Pool capacity, override with -DSHIP_MAX_BULLETS=N
+#endif
+#ifndef MAX_STARS
+#define MAX_STARS 300        // Stars over all parallax layers
+#endif
+#define BASE_STAR_SCROLL_SPEED 530 // Speed of the nearest star layer
+#define SIM_HZ 120                 // Fixed simulation rate, independent of the render rate
+#define SIM_DT (1.0f / SIM_HZ)
+#define MAX_FRAME_TIME 0.25f       // Longest backlog the simulation catches up on after a hitch
+
+#endif // CONFIG_H
@@ -0,0 +1,334 @@
+#include "ecs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "jobs.h"
+#include "arena.h"
+
+#define ECS_INSERTION_SORT_MAX 64 // Pending destroys sorted in place up to this many
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct SystemRun {
+    const EcsStorage *storage;
+    int chunks[ECS_MAX_CHUNKS]; // Matching chunks, in archetype then chunk order
+    EcsSystem system;
+    void *context;
+} SystemRun;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+EcsWorld world;
+
+static const int componentSizes[COMPONENT_COUNT] = {
+    [COMPONENT_POSITION] = sizeof(Vector2),
+    [COMPONENT_PREVIOUS] = sizeof(Vector2),
+    [COMPONENT_VELOCITY] = sizeof(Vector2),
+    [COMPONENT_LIFETIME] = sizeof(float),
+    [COMPONENT_SPRITE]   = sizeof(EcsSprite),
+    [COMPONENT_PICKUP]   = sizeof(float),
+};
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static int AlignColumn(int offset) {
+    return (offset + ECS_COLUMN_ALIGN - 1) & ~(ECS_COLUMN_ALIGN - 1);
+}
+
+static unsigned char *ChunkBytes(const EcsStorage *storage, int chunk) {
+    return (unsigned char *)storage->chunks[chunk].words;
+}
+
+static Entity *ChunkEntities(const EcsStorage *storage, const EcsArchetype *archetype, int chunk) {
+    return (Entity *)(ChunkBytes(storage, chunk) + archetype->entityOffset);
+}
+
+static unsigned char *ComponentAt(const EcsStorage *storage, const EcsArchetype *archetype, int chunk, int row,
+                                  EcsComponent component) {
+    return ChunkBytes(storage, chunk) + archetype->offset[component] + row * componentSizes[component];
+}
+
+static int FindArchetype(uint32_t mask) {
+    EcsStorage *storage = &world.storage;
+    for (int a = 0; a < storage->archetypeCount; a++) {
+        if (storage->archetypes[a].mask == mask) return a;
+    }
+    if (storage->archetypeCount == ECS_MAX_ARCHETYPES) return -1;
+
+    // As many rows as fit once every column after the first is padded to
+    // a cache line
+    int rowBytes = sizeof(Entity);
+    int columns = 1;
+    for (int c = 0; c < COMPONENT_COUNT; c++) {
+        if (mask & ECS_MASK(c)) {
+            rowBytes += componentSizes[c];
+            columns++;
+        }
+    }
+    EcsArchetype *archetype = &storage->archetypes[storage->archetypeCount];
+    archetype->mask = mask;
+    archetype->capacity = (ECS_CHUNK_SIZE - (columns - 1) * (ECS_COLUMN_ALIGN - 1)) / rowBytes;
+    archetype->chunkCount = 0;
+    archetype->count = 0;
+
+    archetype->entityOffset = 0;
+    int offset = AlignColumn(archetype->capacity * (int)sizeof(Entity));
+    for (int c = 0; c < COMPONENT_COUNT; c++) {
+        archetype->offset[c] = -1;
+        if (!(mask & ECS_MASK(c))) continue;
+        archetype->offset[c] = offset;
+        offset = AlignColumn(offset + archetype->capacity * componentSizes[c]);
+    }
+    return storage->archetypeCount++;
+}
+
+static EcsChunkView ViewChunk(const EcsStorage *storage, int chunk) {
+    const EcsArchetype *archetype = &storage->archetypes[storage->chunkArchetype[chunk]];
+    EcsChunkView view;
+    for (int c = 0; c < COMPONENT_COUNT; c++) {
+        view.column[c] = archetype->offset[c] < 0 ? NULL : ChunkBytes(storage, chunk) + archetype->offset[c];
+    }
+    view.entities = ChunkEntities(storage, archetype, chunk);
+    view.count = storage->chunkRows[chunk];
+    return view;
+}
+
+static int MatchChunks(const EcsStorage *storage, uint32_t mask, int *chunks) {
+    int count = 0;
+    for (int a = 0; a < storage->archetypeCount; a++) {
+        const EcsArchetype *archetype = &storage->archetypes[a];
+        if ((archetype->mask & mask) != mask) continue;
+        for (int k = 0; k < archetype->chunkCount; k++) {
+            chunks[count++] = archetype->chunks[k];
+        }
+    }
+    return count;
+}
+
+static void RunSystemRange(void *context, int start, int end) {
+    const SystemRun *run = context;
+    for (int k = start; k < end; k++) {
+        EcsChunkView view = ViewChunk(run->storage, run->chunks[k]);
+        run->system(run->context, &view);
+    }
+}
+
+static int CompareEntities(const void *a, const void *b) {
+    Entity ea = *(const Entity *)a;
+    Entity eb = *(const Entity *)b;
+    return (ea > eb) - (ea < eb);
+}
+
+// Ascending, like qsort with CompareEntities. Most ticks queue a handful of
+// destroys, sorted in place; large batches are radix-sorted with a buffer on
+// scratch, since glibc's qsort mallocs one once the array passes a kilobyte.
+static void SortEntities(Entity *entities, int count) {
+    if (count < 2) return;
+    if (count <= ECS_INSERTION_SORT_MAX) {
+        for (int i = 1; i < count; i++) {
+            Entity entity = entities[i];
+            int j = i;
+            for (; j > 0 && entities[j - 1] > entity; j--) entities[j] = entities[j - 1];
+            entities[j] = entity;
+        }
+        return;
+    }
+
+    Scratch scratch = BeginScratch();
+    Entity *buffer = ArenaPushArray(scratch.arena, Entity, count);
+    if (buffer == NULL) {
+        qsort(entities, count, sizeof(Entity), CompareEntities);
+        EndScratch(scratch);
+        return;
+    }
+    // Four byte-wide LSD passes; an even count leaves the result in place
+    Entity *from = entities;
+    Entity *to = buffer;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int offsets[256] = { 0 };
+        for (int i = 0; i < count; i++) offsets[(from[i] >> shift) & 0xFF]++;
+        int sum = 0;
+        for (int d = 0; d < 256; d++) {
+            int n = offsets[d];
+            offsets[d] = sum;
+            sum += n;
+        }
+        for (int i = 0; i < count; i++) to[offsets[(from[i] >> shift) & 0xFF]++] = from[i];
+        Entity *swap = from;
+        from = to;
+        to = swap;
+    }
+    EndScratch(scratch);
+}
+
+// -----------------------------------------------------------------------------
+// World Functions
+// -----------------------------------------------------------------------------
+void InitWorld(void) {
+    world.storage.archetypeCount = 0;
+    // Free lists are stacks; fill them backwards so ids and chunks are
+    // handed out from 0 up
+    for (int i = 0; i < ECS_MAX_ENTITIES; i++) {
+        world.locations[i].chunk = -1;
+        world.locations[i].generation = 0;
+        world.freeIds[i] = ECS_MAX_ENTITIES - 1 - i;
+    }
+    world.freeIdCount = ECS_MAX_ENTITIES;
+    for (int c = 0; c < ECS_MAX_CHUNKS; c++) {
+        world.freeChunks[c] = ECS_MAX_CHUNKS - 1 - c;
+    }
+    world.freeChunkCount = ECS_MAX_CHUNKS;
+    world.pendingCount = 0;
+    world.entityCount = 0;
+}
+
+Entity CreateEntity(uint32_t mask) {
+    EcsStorage *storage = &world.storage;
+    if (world.freeIdCount == 0) return ECS_NULL_ENTITY;
+    int a = FindArchetype(mask);
+    if (a < 0) return ECS_NULL_ENTITY;
+
+    EcsArchetype *archetype = &storage->archetypes[a];
+    if (archetype->count % archetype->capacity == 0) {
+        // No chunk yet, or the last one is full
+        if (world.freeChunkCount == 0) return ECS_NULL_ENTITY;
+        int chunk = world.freeChunks[--world.freeChunkCount];
+        archetype->chunks[archetype->chunkCount++] = chunk;
+        storage->chunkArchetype[chunk] = a;
+        storage->chunkRows[chunk] = 0;
+    }
+    int chunk = archetype->chunks[archetype->chunkCount - 1];
+    int row = storage->chunkRows[chunk]++;
+    archetype->count++;
+
+    int index = world.freeIds[--world.freeIdCount];
+    EcsLocation *location = &world.locations[index];
+    location->chunk = chunk;
+    location->row = row;
+    Entity entity = (Entity)index | (location->generation << ECS_INDEX_BITS);
+
+    ChunkEntities(storage, archetype, chunk)[row] = entity;
+    for (int c = 0; c < COMPONENT_COUNT; c++) {
+        if (mask & ECS_MASK(c)) memset(ComponentAt(storage, archetype, chunk, row, c), 0, componentSizes[c]);
+    }
+    world.entityCount++;
+    return entity;
+}
+
+bool IsEntityAlive(Entity entity) {
+    int index = entity & ECS_INDEX_MASK;
+    if (entity == ECS_NULL_ENTITY || index >= ECS_MAX_ENTITIES) return false;
+    const EcsLocation *location = &world.locations[index];
+    return location->chunk >= 0 && location->generation == entity >> ECS_INDEX_BITS;
+}
+
+void DestroyEntity(Entity entity) {
+    if (!IsEntityAlive(entity)) return;
+
+    EcsStorage *storage = &world.storage;
+    int index = entity & ECS_INDEX_MASK;
+    EcsLocation *location = &world.locations[index];
+    int chunk = location->chunk;
+    int row = location->row;
+    EcsArchetype *archetype = &storage->archetypes[storage->chunkArchetype[chunk]];
+
+    // Fill the hole with the archetype's last row
+    int lastChunk = archetype->chunks[archetype->chunkCount - 1];
+    int lastRow = --storage->chunkRows[lastChunk];
+    if (lastChunk != chunk || lastRow != row) {
+        Entity moved = ChunkEntities(storage, archetype, lastChunk)[lastRow];
+        ChunkEntities(storage, archetype, chunk)[row] = moved;
+        for (int c = 0; c < COMPONENT_COUNT; c++) {
+            if (!(archetype->mask & ECS_MASK(c))) continue;
+            memcpy(ComponentAt(storage, archetype, chunk, row, c),
+                   ComponentAt(storage, archetype, lastChunk, lastRow, c), componentSizes[c]);
+        }
+        world.locations[moved & ECS_INDEX_MASK].chunk = chunk;
+        world.locations[moved & ECS_INDEX_MASK].row = row;
+    }
+    if (storage->chunkRows[lastChunk] == 0) {
+        archetype->chunkCount--;
+        world.freeChunks[world.freeChunkCount++] = lastChunk;
+    }
+    archetype->count--;
+
+    location->chunk = -1;
+    location->generation = (location->generation + 1) & ECS_GENERATION_MASK;
+    world.freeIds[world.freeIdCount++] = index;
+    world.entityCount--;
+}
+
+void DestroyEntityLater(Entity entity) {
+    int slot = __atomic_fetch_add(&world.pendingCount, 1, __ATOMIC_RELAXED);
+    if (slot < ECS_MAX_ENTITIES) world.pendingDestroy[slot] = entity;
+}
+
+void FlushDestroyedEntities(void) {
+    // Workers queue in whatever order they finish; destroying in id order
+    // keeps the row layout deterministic. Duplicates are already dead by
+    // their second turn.
+    int count = world.pendingCount < ECS_MAX_ENTITIES ? world.pendingCount : ECS_MAX_ENTITIES;
+    SortEntities(world.pendingDestroy, count);
+    for (int i = 0; i < count; i++) {
+        DestroyEntity(world.pendingDestroy[i]);
+    }
+    world.pendingCount = 0;
+}
+
+void *GetComponent(Entity entity, EcsComponent component) {
+    if (!IsEntityAlive(entity)) return NULL;
+    const EcsStorage *storage = &world.storage;
+    const EcsLocation *location = &world.locations[entity & ECS_INDEX_MASK];
+    const EcsArchetype *archetype = &storage->archetypes[storage->chunkArchetype[location->chunk]];
+    if (archetype->offset[component] < 0) return NULL;
+    return ComponentAt(storage, archetype, location->chunk, location->row, component);
+}
+
+int CountEntities(uint32_t mask) {
+    int count = 0;
+    for (int a = 0; a < world.storage.archetypeCount; a++) {
+        const EcsArchetype *archetype = &world.storage.archetypes[a];
+        if ((archetype->mask & mask) == mask) count += archetype->count;
+    }
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+// System Iteration
+// -----------------------------------------------------------------------------
+void RunSystem(const EcsStorage *storage, uint32_t mask, EcsSystem system, void *context) {
+    SystemRun run = { .storage = storage, .system = system, .context = context };
+    int count = MatchChunks(storage, mask, run.chunks);
+    ParallelFor(count, ECS_SYSTEM_GRAIN, RunSystemRange, &run);
+}
+
+void ForEachChunk(const EcsStorage *storage, uint32_t mask, EcsSystem system, void *context) {
+    SystemRun run = { .storage = storage, .system = system, .context = context };
+    RunSystemRange(&run, 0, MatchChunks(storage, mask, run.chunks));
+}
+
+void CopyStorage(EcsStorage *dst, const EcsStorage *src, uint32_t mask) {
+    // Chunks keep their pool index, so the copied archetypes' chunk lists
+    // stay valid; the others are emptied in the copy
+    dst->archetypeCount = src->archetypeCount;
+    for (int a = 0; a < src->archetypeCount; a++) {
+        const EcsArchetype *from = &src->archetypes[a];
+        EcsArchetype *to = &dst->archetypes[a];
+        *to = *from;
+        if ((from->mask & mask) != mask) {
+            to->chunkCount = 0;
+            to->count = 0;
+            continue;
+        }
+        for (int k = 0; k < from->chunkCount; k++) {
+            int chunk = from->chunks[k];
+            dst->chunkArchetype[chunk] = a;
+            dst->chunkRows[chunk] = src->chunkRows[chunk];
+            memcpy(&dst->chunks[chunk], &src->chunks[chunk], sizeof(EcsChunk));
+        }
+    }
+}
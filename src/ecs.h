@@ -0,0 +1,160 @@
+#ifndef ECS_H
+#define ECS_H
+
+#include "raylib.h"
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Archetype entity-component storage
+// -----------------------------------------------------------------------------
+// Entities with the same set of components (an archetype) live together in
+// 16 KB chunks. Each chunk holds one packed column per component plus the
+// entity ids, so a system that reads positions and velocities streams two
+// arrays per chunk. A system names the components it needs and runs over
+// every chunk whose archetype has them all, whatever else it carries: a new
+// kind of object is a new component set, not another Init/Update/Draw loop.
+//
+// Rows stay packed: destroying an entity moves its archetype's last row into
+// the hole. Systems must not create or destroy entities while they run;
+// they queue destroys with DestroyEntityLater, and FlushDestroyedEntities
+// applies them in entity order so the layout is the same on any thread count.
+//
+// The ECS is home to gameplay objects that share movement, expiry, culling
+// and sprite drawing: pickups today, and new kinds after them. The hot pools
+// deliberately stay flat SoA arrays:
+//   bullets    one array per field feeds the SIMD integrate and sweep
+//              kernels in a single pass; RemoveBullets compacts in pool
+//              order, which replays depend on
+//   enemies    the spatial hash stores pool indices into enemies.x/y, and
+//              hits index hp by the same slot
+//   particles  a ring buffer with no per-particle destroy
+//   stars      a fixed pattern scrolled by one offset per layer; no
+//              per-star state changes
+// Chunking any of them would cut those arrays into ~16 KB runs and turn pool
+// indices into (chunk, row) pairs for no gain in what they do.
+
+#define ECS_CHUNK_SIZE 16384
+#define ECS_COLUMN_ALIGN 64  // Columns start on cache lines
+#ifndef ECS_MAX_CHUNKS
+#define ECS_MAX_CHUNKS 64    // Chunk pool capacity, override with -DECS_MAX_CHUNKS=N
+#endif
+#ifndef ECS_MAX_ENTITIES
+#define ECS_MAX_ENTITIES 16384
+#endif
+#define ECS_MAX_ARCHETYPES 32
+#define ECS_SYSTEM_GRAIN 4   // Chunks per job when a system is split across workers
+
+#define ECS_INDEX_BITS 20    // Entity ids: slot in the low bits, generation above
+#define ECS_INDEX_MASK ((1u << ECS_INDEX_BITS) - 1)
+#define ECS_NULL_ENTITY 0xFFFFFFFFu
+#define ECS_GENERATION_MASK (ECS_NULL_ENTITY >> ECS_INDEX_BITS)
+
+#if ECS_MAX_ENTITIES >= (1 << ECS_INDEX_BITS) // The all-ones index is ECS_NULL_ENTITY
+#error "ECS_MAX_ENTITIES does not fit in ECS_INDEX_BITS"
+#endif
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef enum EcsComponent {
+    COMPONENT_POSITION = 0, // Vector2
+    COMPONENT_PREVIOUS,     // Vector2, position a tick ago for render interpolation
+    COMPONENT_VELOCITY,     // Vector2, px/s
+    COMPONENT_LIFETIME,     // float, seconds until the entity expires
+    COMPONENT_SPRITE,       // EcsSprite
+    COMPONENT_PICKUP,       // float, radius the ship collects it within
+    COMPONENT_COUNT
+} EcsComponent;
+
+#define ECS_MASK(component) (1u << (component))
+
+typedef uint32_t Entity;
+
+typedef struct EcsSprite {
+    int frame;              // SpriteId
+    Color tint;
+} EcsSprite;
+
+typedef struct EcsArchetype {
+    uint32_t mask;
+    int capacity;                  // Rows per chunk
+    int offset[COMPONENT_COUNT];   // Column byte offsets in a chunk, -1 when absent
+    int entityOffset;              // The Entity column
+    int chunks[ECS_MAX_CHUNKS];    // Pool indices; every chunk but the last is full
+    int chunkCount;
+    int count;
+} EcsArchetype;
+
+typedef struct EcsChunk {
+    uint64_t words[ECS_CHUNK_SIZE / sizeof(uint64_t)]; // Aligned for every component type
+} EcsChunk;
+
+// Everything systems iterate. Snapshots copy this part of the world.
+typedef struct EcsStorage {
+    EcsChunk chunks[ECS_MAX_CHUNKS];
+    int chunkArchetype[ECS_MAX_CHUNKS];
+    int chunkRows[ECS_MAX_CHUNKS];
+    EcsArchetype archetypes[ECS_MAX_ARCHETYPES];
+    int archetypeCount;
+} EcsStorage;
+
+typedef struct EcsLocation {
+    int chunk;              // -1 while the slot is free
+    int row;
+    uint32_t generation;
+} EcsLocation;
+
+typedef struct EcsWorld {
+    EcsStorage storage;
+    EcsLocation locations[ECS_MAX_ENTITIES];
+    int freeIds[ECS_MAX_ENTITIES];
+    int freeIdCount;
+    int freeChunks[ECS_MAX_CHUNKS];
+    int freeChunkCount;
+    Entity pendingDestroy[ECS_MAX_ENTITIES];
+    int pendingCount;
+    int entityCount;
+} EcsWorld;
+
+// What a system sees of one chunk. Columns the archetype lacks are NULL.
+typedef struct EcsChunkView {
+    void *column[COMPONENT_COUNT];
+    const Entity *entities;
+    int count;
+} EcsChunkView;
+
+typedef void (*EcsSystem)(void *context, EcsChunkView *chunk);
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern EcsWorld world;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitWorld(void);
+// New entity with the given components, zeroed. Returns ECS_NULL_ENTITY when
+// the entity table, the chunk pool or the archetype table is full.
+Entity CreateEntity(uint32_t mask);
+void DestroyEntity(Entity entity);
+void DestroyEntityLater(Entity entity); // Safe from inside a system, on any worker
+void FlushDestroyedEntities(void);
+bool IsEntityAlive(Entity entity);
+// Component of a live entity, or NULL if it has none
+void *GetComponent(Entity entity, EcsComponent component);
+int CountEntities(uint32_t mask);
+
+// Run system over every chunk whose archetype has all components in mask,
+// spread across the job workers ECS_SYSTEM_GRAIN chunks at a time. The
+// views point into storage, so a system may write the columns of the
+// storage it was given.
+void RunSystem(const EcsStorage *storage, uint32_t mask, EcsSystem system, void *context);
+// Same, serially on the calling thread in chunk order, for work that must
+// stay there (drawing) or works on a snapshot copy
+void ForEachChunk(const EcsStorage *storage, uint32_t mask, EcsSystem system, void *context);
+// Copy the chunks of archetypes matching mask into dst, which then iterates
+// like the live storage
+void CopyStorage(EcsStorage *dst, const EcsStorage *src, uint32_t mask);
+
+#endif // ECS_H
@@ -0,0 +1,79 @@
+#include "emitters.h"
+
+#include <math.h>
+
+#include "bullets.h"
+
+// -----------------------------------------------------------------------------
+// Emitter Functions
+// -----------------------------------------------------------------------------
+void InitEmitter(Emitter *emitter, BulletPattern pattern, Vector2 position) {
+    emitter->pattern = pattern;
+    emitter->position = position;
+    emitter->angle = pattern.angle;
+    emitter->timer = 0.0f; // First volley fires on the first update
+}
+
+int UpdateEmitter(Emitter *emitter, Vector2 target, float deltaTime) {
+    const BulletPattern *pattern = &emitter->pattern;
+    int spawned = 0;
+
+    emitter->timer -= deltaTime;
+    while (emitter->timer <= 0.0f) {
+        float angle = emitter->angle;
+        if (pattern->aimed) {
+            angle = atan2f(target.y - emitter->position.y, target.x - emitter->position.x);
+        }
+        spawned += EmitVolley(pattern, emitter->position, angle);
+
+        emitter->angle += pattern->angularVelocity * pattern->interval;
+        if (pattern->interval <= 0.0f) {
+            emitter->timer = 0.0f;
+            break; // No interval means one volley per update
+        }
+        emitter->timer += pattern->interval;
+    }
+
+    return spawned;
+}
+
+int EmitVolley(const BulletPattern *pattern, Vector2 origin, float angle) {
+    int granted;
+    int first = ReserveBullets(pattern->count, &granted);
+    if (granted == 0) return 0;
+
+    // A ring spaces count bullets evenly around the circle; a fan puts the
+    // first and last bullet on the edges of the arc
+    bool ring = pattern->spread >= EMITTER_FULL_CIRCLE;
+    float step = 0.0f;
+    if (pattern->count > 1) {
+        step = ring ? pattern->spread / pattern->count : pattern->spread / (pattern->count - 1);
+    }
+    float start = ring ? angle : angle - pattern->spread * 0.5f;
+
+    // One sin/cos pair for the start direction and one for the step, then
+    // rotate the direction vector per bullet instead of calling sinf/cosf
+    // for every bullet in the volley
+    float dirX = cosf(start);
+    float dirY = sinf(start);
+    float stepCos = cosf(step);
+    float stepSin = sinf(step);
+
+    float *x = bullets.x + first;
+    float *y = bullets.y + first;
+    float *vx = bullets.vx + first;
+    float *vy = bullets.vy + first;
+    for (int i = 0; i < granted; i++) {
+        float speed = pattern->speed + pattern->speedStep * i;
+        x[i] = origin.x;
+        y[i] = origin.y;
+        vx[i] = dirX * speed;
+        vy[i] = dirY * speed;
+
+        float nextX = dirX * stepCos - dirY * stepSin;
+        dirY = dirX * stepSin + dirY * stepCos;
+        dirX = nextX;
+    }
+
+    return granted;
+}
@@ -0,0 +1,52 @@
+#ifndef EMITTERS_H
+#define EMITTERS_H
+
+#include "raylib.h"
+
+// -----------------------------------------------------------------------------
+// Bullet-pattern emitters
+// -----------------------------------------------------------------------------
+// A pattern describes one volley (how many bullets, over what arc, at what
+// speeds) and how volleys repeat (interval and rotation between volleys).
+// Radial rings, spirals and aimed fans are all the same description:
+//
+//     ring:   count 32, spread 2*PI
+//     spiral: count 4,  spread 2*PI, angularVelocity 3, interval 0.05
+//     aimed:  count 5,  spread 0.5,  aimed true
+
+#define EMITTER_FULL_CIRCLE (2.0f * PI)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct BulletPattern {
+    int count;             // Bullets per volley
+    float spread;          // Arc covered by the volley in radians, EMITTER_FULL_CIRCLE for a ring
+    float angle;           // Direction of the volley center in radians, -PI/2 is straight up
+    float angularVelocity; // Radians per second the volley center turns, for spirals
+    float speed;           // Speed of the first bullet in the volley
+    float speedStep;       // Speed added per bullet along the volley, for speed curves
+    float interval;        // Seconds between volleys
+    bool aimed;            // Point the volley center at the target instead of angle
+} BulletPattern;
+
+typedef struct Emitter {
+    BulletPattern pattern;
+    Vector2 position;
+    float angle;           // Current volley center, advanced by angularVelocity
+    float timer;           // Seconds until the next volley
+} Emitter;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitEmitter(Emitter *emitter, BulletPattern pattern, Vector2 position);
+// Advance the emitter and fire every volley that came due. target is only
+// read by aimed patterns. Returns the number of bullets spawned.
+int UpdateEmitter(Emitter *emitter, Vector2 target, float deltaTime);
+// Spawn one whole volley centered on angle into the bullet pool with a
+// single reservation. Returns the number of bullets spawned, which is lower
+// than pattern->count when the pool is nearly full.
+int EmitVolley(const BulletPattern *pattern, Vector2 origin, float angle);
+
+#endif // EMITTERS_H
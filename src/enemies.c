@@ -0,0 +1,207 @@
+#include "enemies.h"
+
+#include <math.h>
+
+#include "bullets.h"
+#include "spatial_hash.h"
+#include "atlas.h"
+#include "particles.h"
+#include "pickups.h"
+#include "jobs.h"
+#include "arena.h"
+
+// -----------------------------------------------------------------------------
+// Constants
+// -----------------------------------------------------------------------------
+#define ENEMY_SINE_FREQUENCY 2.5f   // rad/s
+#define ENEMY_ZIGZAG_PERIOD 1.6f    // s for one full left-right-left sweep
+
+// ResolveBulletHits keeps a hit flag, target and time of impact per bullet
+// on scratch; raise SCRATCH_ARENA_SIZE along with SHIP_MAX_BULLETS
+#if (SHIP_MAX_BULLETS) * 9ull + 3 * ARENA_ALIGNMENT > (SCRATCH_ARENA_SIZE)
+#error "SCRATCH_ARENA_SIZE is too small for SHIP_MAX_BULLETS bullets"
+#endif
+// ResolveShipCollisions keeps a velocity, time of impact and hit per enemy
+#if (MAX_ENEMIES) * 16ull + 4 * ARENA_ALIGNMENT > (SCRATCH_ARENA_SIZE)
+#error "SCRATCH_ARENA_SIZE is too small for MAX_ENEMIES enemies"
+#endif
+// Every enemy has to fit in the broadphase, or those past the cap are never hit
+#if MAX_ENEMIES > SPATIAL_HASH_MAX_TARGETS
+#error "SPATIAL_HASH_MAX_TARGETS is smaller than MAX_ENEMIES"
+#endif
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+EnemyPool enemies;
+
+static SpatialHash enemyHash;
+
+// -----------------------------------------------------------------------------
+// Enemy Functions
+// -----------------------------------------------------------------------------
+void InitEnemies(void) {
+    enemies.count = 0;
+}
+
+void SpawnEnemy(EnemyPattern pattern, float x, float speed, float hp, float amplitude) {
+    if (enemies.count >= MAX_ENEMIES) return; // Pool exhausted, drop the spawn
+
+    int i = enemies.count++;
+    enemies.x[i] = enemies.prevX[i] = enemies.originX[i] = x;
+    enemies.y[i] = enemies.prevY[i] = ENEMY_SPAWN_Y;
+    enemies.age[i] = 0.0f;
+    enemies.speed[i] = speed;
+    enemies.amplitude[i] = amplitude;
+    enemies.hp[i] = hp;
+    enemies.radius[i] = ENEMY_RADIUS;
+    enemies.pattern[i] = (unsigned char)pattern;
+}
+
+static float PatternOffsetX(int pattern, float age, float amplitude) {
+    switch (pattern) {
+        case ENEMY_PATTERN_SINE:
+            return amplitude * sinf(age * ENEMY_SINE_FREQUENCY);
+        case ENEMY_PATTERN_ZIGZAG: {
+            // Triangle wave in [-amplitude, amplitude]
+            float phase = fmodf(age / ENEMY_ZIGZAG_PERIOD, 1.0f);
+            return amplitude * (4.0f * fabsf(phase - 0.5f) - 1.0f);
+        }
+        default:
+            return 0.0f;
+    }
+}
+
+static void AdvanceEnemyRange(void *context, int start, int end) {
+    float deltaTime = *(const float *)context;
+    for (int i = start; i < end; i++) {
+        enemies.prevX[i] = enemies.x[i];
+        enemies.prevY[i] = enemies.y[i];
+        enemies.age[i] += deltaTime;
+        enemies.x[i] = enemies.originX[i] + PatternOffsetX(enemies.pattern[i], enemies.age[i], enemies.amplitude[i]);
+        enemies.y[i] = ENEMY_SPAWN_Y + enemies.speed[i] * enemies.age[i];
+        enemies.offscreen[i] = enemies.y[i] > SCREEN_HEIGHT + ENEMY_RADIUS || enemies.hp[i] <= 0.0f;
+    }
+}
+
+void UpdateEnemies(float deltaTime) {
+    // Same shape as UpdateBullets: one parallel pass that advances every
+    // enemy and writes the offscreen mask, then a serial swap-remove pass
+    ParallelFor(enemies.count, JOB_GRAIN, AdvanceEnemyRange, &deltaTime);
+
+    for (int i = enemies.count - 1; i >= 0; i--) {
+        if (enemies.offscreen[i]) {
+            if (enemies.hp[i] <= 0.0f) {
+                SpawnExplosion((Vector2){ enemies.x[i], enemies.y[i] }, EXPLOSION_PARTICLES, EXPLOSION_COLOR);
+                SpawnPickup((Vector2){ enemies.x[i], enemies.y[i] });
+            }
+            int last = --enemies.count;
+            enemies.x[i] = enemies.x[last];
+            enemies.y[i] = enemies.y[last];
+            enemies.prevX[i] = enemies.prevX[last];
+            enemies.prevY[i] = enemies.prevY[last];
+            enemies.originX[i] = enemies.originX[last];
+            enemies.age[i] = enemies.age[last];
+            enemies.speed[i] = enemies.speed[last];
+            enemies.amplitude[i] = enemies.amplitude[last];
+            enemies.hp[i] = enemies.hp[last];
+            enemies.radius[i] = enemies.radius[last];
+            enemies.pattern[i] = enemies.pattern[last];
+        }
+    }
+}
+
+int ResolveBulletHits(float deltaTime) {
+    if (enemies.count == 0 || bullets.count == 0) return 0;
+
+    Scratch scratch = BeginScratch();
+    unsigned char *bulletHit = ArenaPushArray(scratch.arena, unsigned char, bullets.count);
+    int *bulletTarget = ArenaPushArray(scratch.arena, int, bullets.count);
+    float *bulletToi = ArenaPushArray(scratch.arena, float, bullets.count);
+    if (bulletHit == NULL || bulletTarget == NULL || bulletToi == NULL) {
+        EndScratch(scratch);
+        return 0;
+    }
+
+    // Swept over the whole tick so a bullet that jumped over an enemy
+    // between two positions still hits it; each bullet damages only the
+    // enemy it reached first
+    BuildSweptSpatialHash(&enemyHash, enemies.x, enemies.y, enemies.prevX, enemies.prevY, enemies.radius,
+                          enemies.count);
+    int hits = QuerySweptHits(&enemyHash, bullets.x, bullets.y, bullets.vx, bullets.vy, deltaTime, BULLET_RADIUS,
+                              bullets.count, bulletTarget, bulletToi);
+    for (int b = 0; b < bullets.count; b++) {
+        bulletHit[b] = bulletTarget[b] >= 0;
+        if (bulletHit[b]) enemies.hp[bulletTarget[b]] -= 1.0f;
+    }
+
+    // Destroyed enemies are culled by the next UpdateEnemies pass
+    if (hits > 0) RemoveBullets(bulletHit);
+    EndScratch(scratch);
+    return hits;
+}
+
+int ResolveShipCollisions(Vector2 shipCenter, Vector2 shipMoved, Vector2 shipHalfSize, float deltaTime) {
+    if (enemies.count == 0) return 0;
+
+    Scratch scratch = BeginScratch();
+    float *vx = ArenaPushArray(scratch.arena, float, enemies.count);
+    float *vy = ArenaPushArray(scratch.arena, float, enemies.count);
+    float *toi = ArenaPushArray(scratch.arena, float, enemies.count);
+    int *hit = ArenaPushArray(scratch.arena, int, enemies.count);
+    if (vx == NULL || vy == NULL || toi == NULL || hit == NULL) {
+        EndScratch(scratch);
+        return 0;
+    }
+
+    // Each enemy's path this tick against the ship's box, both moving, with
+    // the enemy's radius folded into the box
+    for (int i = 0; i < enemies.count; i++) {
+        vx[i] = (enemies.x[i] - enemies.prevX[i]) / deltaTime;
+        vy[i] = (enemies.y[i] - enemies.prevY[i]) / deltaTime;
+        toi[i] = SWEEP_MISS;
+        hit[i] = -1;
+    }
+    SweepTarget ship = {
+        .x = shipCenter.x,
+        .y = shipCenter.y,
+        .dx = shipMoved.x,
+        .dy = shipMoved.y,
+        .halfWidth = shipHalfSize.x + ENEMY_RADIUS,
+        .halfHeight = shipHalfSize.y + ENEMY_RADIUS,
+        .id = 0
+    };
+    SweepBox(enemies.x, enemies.y, vx, vy, enemies.count, deltaTime, &ship, toi, hit);
+
+    // An enemy that reaches the ship is destroyed by the impact and culled
+    // by the next UpdateEnemies pass, like one shot down
+    int collisions = 0;
+    for (int i = 0; i < enemies.count; i++) {
+        if (hit[i] < 0 || enemies.hp[i] <= 0.0f) continue;
+        enemies.hp[i] = 0.0f;
+        collisions++;
+    }
+    EndScratch(scratch);
+    return collisions;
+}
+
+int CountActiveEnemies(void) {
+    return enemies.count;
+}
+
+// -----------------------------------------------------------------------------
+// Enemy Rendering
+// -----------------------------------------------------------------------------
+void DrawEnemies(const EnemyPool *pool, float alpha) {
+    if (!atlas.loaded) return;
+
+    Rectangle frame = atlas.frames[SPRITE_ENEMY];
+    float half = frame.width / 2.0f;
+    for (int i = 0; i < pool->count; i++) {
+        Vector2 position = {
+            pool->prevX[i] + (pool->x[i] - pool->prevX[i]) * alpha - half,
+            pool->prevY[i] + (pool->y[i] - pool->prevY[i]) * alpha - half
+        };
+        DrawTextureRec(atlas.texture, frame, position, ENEMY_COLOR);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef ENEMIES_H
+#define ENEMIES_H
+
+#include "raylib.h"
+#include "config.h"
+#include "waves.h"
+
+#ifndef MAX_ENEMIES
+#define MAX_ENEMIES 512  // Pool capacity, override with -DMAX_ENEMIES=N
+#endif
+#define ENEMY_RADIUS 12
+#define ENEMY_COLOR ORANGE
+#define ENEMY_SPAWN_Y (-ENEMY_RADIUS * 2.0f)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+// Structure-of-arrays enemy pool, packed densely in [0..count) like the
+// bullets. Positions are evaluated from each enemy's age and pattern, so
+// the previous position is kept for render interpolation.
+typedef struct EnemyPool {
+    float x[MAX_ENEMIES];
+    float y[MAX_ENEMIES];
+    float prevX[MAX_ENEMIES];
+    float prevY[MAX_ENEMIES];
+    float originX[MAX_ENEMIES];
+    float age[MAX_ENEMIES];
+    float speed[MAX_ENEMIES];
+    float amplitude[MAX_ENEMIES];
+    float hp[MAX_ENEMIES];
+    float radius[MAX_ENEMIES]; // All ENEMY_RADIUS today; kept per enemy for the broadphase
+    unsigned char pattern[MAX_ENEMIES];
+    unsigned char offscreen[MAX_ENEMIES]; // Left the field or destroyed this tick
+    int count;
+} EnemyPool;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern EnemyPool enemies;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitEnemies(void);
+void SpawnEnemy(EnemyPattern pattern, float x, float speed, float hp, float amplitude);
+void UpdateEnemies(float deltaTime);
+// Despawn every bullet whose path over the last deltaTime touched an enemy
+// and damage that enemy. Run after UpdateBullets and UpdateEnemies with the
+// same deltaTime; returns the number of hits.
+int ResolveBulletHits(float deltaTime);
+// Destroy every enemy whose path over the last deltaTime touched the ship's
+// box, centered on shipCenter after moving by shipMoved this tick. Run after
+// UpdateEnemies; returns the number of enemies that hit the ship.
+int ResolveShipCollisions(Vector2 shipCenter, Vector2 shipMoved, Vector2 shipHalfSize, float deltaTime);
+int CountActiveEnemies(void);
+
+// Draw from the live pool or a snapshot copy of it (see snapshot.h). alpha
+// in [0, 1] is how far the render time sits between the previous and the
+// current simulation tick
+void DrawEnemies(const EnemyPool *pool, float alpha);
+
+#endif // ENEMIES_H
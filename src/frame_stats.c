@@ -0,0 +1,102 @@
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+
+#include "frame_stats.h"
+
+#include "raylib.h"
+#include <string.h>
+#include <time.h>
+
+// -----------------------------------------------------------------------------
+// Bucketing
+// -----------------------------------------------------------------------------
+// Values below FRAME_HIST_SUB_BUCKETS us get one bucket each. Above that,
+// octave k (values with their top bit at FRAME_HIST_SUB_BITS + k) keeps the
+// top FRAME_HIST_SUB_BITS + 1 bits, i.e. a bucket width of 2^k us.
+static int BucketIndex(uint64_t us) {
+    if (us < FRAME_HIST_SUB_BUCKETS) return (int)us;
+
+    int top = 63 - __builtin_clzll(us);
+    int shift = top - FRAME_HIST_SUB_BITS;
+    if (shift >= FRAME_HIST_OCTAVES) return FRAME_HIST_BUCKETS - 1; // Clamp the far tail
+    return (shift + 1) * FRAME_HIST_SUB_BUCKETS + (int)((us >> shift) - FRAME_HIST_SUB_BUCKETS);
+}
+
+static uint64_t BucketUpperUs(int index) {
+    if (index < FRAME_HIST_SUB_BUCKETS) return (uint64_t)index;
+
+    int shift = index / FRAME_HIST_SUB_BUCKETS - 1;
+    uint64_t base = (uint64_t)(index % FRAME_HIST_SUB_BUCKETS + FRAME_HIST_SUB_BUCKETS) << shift;
+    return base + ((uint64_t)1 << shift) - 1;
+}
+
+// -----------------------------------------------------------------------------
+// Frame Stats Functions
+// -----------------------------------------------------------------------------
+void InitFrameStats(FrameStats *stats, double budgetMs) {
+    memset(stats, 0, sizeof(*stats));
+    stats->budgetUs = (uint64_t)(budgetMs * 1000.0);
+}
+
+void RecordFrameTime(FrameStats *stats, uint64_t ns) {
+    uint64_t us = ns / 1000;
+    stats->buckets[BucketIndex(us)]++;
+    stats->count++;
+    stats->totalUs += us;
+    if (us > stats->maxUs) stats->maxUs = us;
+    if (us > stats->budgetUs) stats->budgetMisses++;
+}
+
+double GetFrameTimePercentile(const FrameStats *stats, double percentile) {
+    if (stats->count == 0) return 0.0;
+
+    // Nearest-rank: the smallest value with at least percentile% at or below it
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)stats->count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > stats->count) rank = stats->count;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < FRAME_HIST_BUCKETS; i++) {
+        seen += stats->buckets[i];
+        if (seen >= rank) {
+            uint64_t us = BucketUpperUs(i);
+            if (us > stats->maxUs) us = stats->maxUs; // Never report past the real max
+            return (double)us / 1000.0;
+        }
+    }
+    return (double)stats->maxUs / 1000.0;
+}
+
+FrameStatsSummary SummarizeFrameStats(const FrameStats *stats) {
+    FrameStatsSummary summary = {
+        .count = stats->count,
+        .budgetMisses = stats->budgetMisses,
+        .meanMs = stats->count > 0 ? (double)stats->totalUs / (double)stats->count / 1000.0 : 0.0,
+        .p50Ms = GetFrameTimePercentile(stats, 50.0),
+        .p95Ms = GetFrameTimePercentile(stats, 95.0),
+        .p99Ms = GetFrameTimePercentile(stats, 99.0),
+        .maxMs = (double)stats->maxUs / 1000.0
+    };
+    return summary;
+}
+
+void WriteFrameStatsJson(FILE *file, const char *name, const FrameStats *stats) {
+    FrameStatsSummary s = SummarizeFrameStats(stats);
+    fprintf(file, "\"%s\": {\"count\": %llu, \"budget_ms\": %.3f, \"budget_misses\": %llu, "
+                  "\"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f}",
+            name, (unsigned long long)s.count, (double)stats->budgetUs / 1000.0, (unsigned long long)s.budgetMisses,
+            s.meanMs, s.p50Ms, s.p95Ms, s.p99Ms, s.maxMs);
+}
+
+void DrawFrameStatsOverlay(const FrameStats *stats, int x, int y) {
+    FrameStatsSummary s = SummarizeFrameStats(stats);
+    DrawRectangle(x - 4, y - 4, 230, 32, Fade(BLACK, 0.6f));
+    DrawText(TextFormat("cpu p50 %5.2f p95 %5.2f p99 %5.2f", s.p50Ms, s.p95Ms, s.p99Ms), x, y, 10, RAYWHITE);
+    DrawText(TextFormat("max %6.2f ms, %llu over budget", s.maxMs, (unsigned long long)s.budgetMisses),
+             x, y + 12, 10, s.budgetMisses > 0 ? ORANGE : RAYWHITE);
+}
+
+uint64_t ThreadCpuNowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
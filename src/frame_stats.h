@@ -0,0 +1,63 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// -----------------------------------------------------------------------------
+// Frame-time histogram
+// -----------------------------------------------------------------------------
+// Records every sample into an HDR-style log-linear histogram: each power of
+// two of microseconds is split into FRAME_HIST_SUB_BUCKETS linear buckets,
+// so any percentile is exact to within 1/FRAME_HIST_SUB_BUCKETS of its value
+// whether a run has a thousand frames or a million, in constant memory.
+// Samples above the budget are counted as misses.
+
+#define FRAME_BUDGET_MS (1000.0 / 60.0)
+#define FRAME_HIST_SUB_BITS 7                          // 128 buckets per octave, < 0.8% error
+#define FRAME_HIST_SUB_BUCKETS (1 << FRAME_HIST_SUB_BITS)
+#define FRAME_HIST_OCTAVES 20                          // Up to ~2^27 us, over two minutes
+#define FRAME_HIST_BUCKETS (FRAME_HIST_SUB_BUCKETS * (FRAME_HIST_OCTAVES + 1))
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct FrameStats {
+    uint32_t buckets[FRAME_HIST_BUCKETS];
+    uint64_t count;
+    uint64_t totalUs;
+    uint64_t maxUs;       // Exact, not bucketed
+    uint64_t budgetUs;
+    uint64_t budgetMisses;
+} FrameStats;
+
+typedef struct FrameStatsSummary {
+    uint64_t count;
+    uint64_t budgetMisses;
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double maxMs;
+} FrameStatsSummary;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitFrameStats(FrameStats *stats, double budgetMs);
+void RecordFrameTime(FrameStats *stats, uint64_t ns);
+// percentile in [0, 100]; the upper edge of the bucket holding that rank
+double GetFrameTimePercentile(const FrameStats *stats, double percentile);
+FrameStatsSummary SummarizeFrameStats(const FrameStats *stats);
+
+// Writes `"name": { ... }` with the summary in ms, for embedding in a
+// larger JSON object
+void WriteFrameStatsJson(FILE *file, const char *name, const FrameStats *stats);
+void DrawFrameStatsOverlay(const FrameStats *stats, int x, int y);
+
+// CPU time consumed by the calling thread, so waits for vsync or the frame
+// limiter do not count as frame cost
+uint64_t ThreadCpuNowNs(void);
+
+#endif // FRAME_STATS_H
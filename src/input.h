@@ -0,0 +1,41 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+// Player intent for one simulation tick, decoupled from where it came from
+// (keyboard, headless script or a recorded replay)
+typedef struct PlayerInput {
+    bool left;
+    bool right;
+    bool up;
+    bool down;
+    bool shoot;
+    bool special; // Hold for the spiral emitter
+} PlayerInput;
+
+// -----------------------------------------------------------------------------
+// Packing, one bit per button
+// -----------------------------------------------------------------------------
+static inline uint8_t PackPlayerInput(PlayerInput input) {
+    return (uint8_t)(input.left << 0 | input.right << 1 | input.up << 2 |
+                     input.down << 3 | input.shoot << 4 | input.special << 5);
+}
+
+static inline PlayerInput UnpackPlayerInput(uint8_t bits) {
+    PlayerInput input = {
+        .left = (bits >> 0) & 1,
+        .right = (bits >> 1) & 1,
+        .up = (bits >> 2) & 1,
+        .down = (bits >> 3) & 1,
+        .shoot = (bits >> 4) & 1,
+        .special = (bits >> 5) & 1
+    };
+    return input;
+}
+
+#endif // INPUT_H
@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 200112L // pthreads, sysconf
+
+#include "jobs.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+// The ParallelFor call being worked on. Written under the lock before the
+// workers are woken; only nextChunk changes while they run.
+typedef struct JobBatch {
+    ParallelForFunc fn;
+    void *context;
+    int count;
+    int grain;
+    int chunkCount;
+    int nextChunk; // Claimed with an atomic increment
+} JobBatch;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+static pthread_t workers[JOB_MAX_WORKERS];
+static int workerCount;
+
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobWake = PTHREAD_COND_INITIALIZER;  // New batch or shutdown
+static pthread_cond_t jobDone = PTHREAD_COND_INITIALIZER;  // Last worker left the batch
+static JobBatch batch;
+static unsigned generation;  // Bumped once per batch
+static int busyWorkers;      // Workers that have not finished the current batch
+static unsigned long long dispatchCount;
+static bool quitting;
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static void RunChunks(void) {
+    for (;;) {
+        int chunk = __atomic_fetch_add(&batch.nextChunk, 1, __ATOMIC_RELAXED);
+        if (chunk >= batch.chunkCount) return;
+
+        int start = chunk * batch.grain;
+        int end = start + batch.grain < batch.count ? start + batch.grain : batch.count;
+        batch.fn(batch.context, start, end);
+    }
+}
+
+static void *WorkerMain(void *arg) {
+    (void)arg;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&jobLock);
+    for (;;) {
+        while (generation == seen && !quitting) pthread_cond_wait(&jobWake, &jobLock);
+        if (quitting) break;
+        seen = generation;
+        pthread_mutex_unlock(&jobLock);
+
+        RunChunks();
+
+        pthread_mutex_lock(&jobLock);
+        if (--busyWorkers == 0) pthread_cond_signal(&jobDone);
+    }
+    pthread_mutex_unlock(&jobLock);
+    return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Job Functions
+// -----------------------------------------------------------------------------
+void InitJobSystem(int requested) {
+    if (workerCount > 0) ShutdownJobSystem();
+
+    if (requested == JOB_WORKERS_AUTO) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        requested = cores > 1 ? (int)cores - 1 : 0;
+    }
+    if (requested > JOB_MAX_WORKERS) requested = JOB_MAX_WORKERS;
+
+    // Workers start expecting generation 0; a previous job system may have
+    // left it anywhere, and its stale batch must not run again
+    quitting = false;
+    generation = 0;
+    busyWorkers = 0;
+    dispatchCount = 0;
+    for (int w = 0; w < requested; w++) {
+        if (pthread_create(&workers[w], NULL, WorkerMain, NULL) != 0) {
+            fprintf(stderr, "jobs: started %d of %d workers\n", w, requested);
+            break;
+        }
+        workerCount++;
+    }
+}
+
+void ShutdownJobSystem(void) {
+    pthread_mutex_lock(&jobLock);
+    quitting = true;
+    pthread_cond_broadcast(&jobWake);
+    pthread_mutex_unlock(&jobLock);
+
+    for (int w = 0; w < workerCount; w++) {
+        pthread_join(workers[w], NULL);
+    }
+    workerCount = 0;
+}
+
+int GetJobWorkerCount(void) {
+    return workerCount;
+}
+
+unsigned long long GetJobDispatchCount(void) {
+    return dispatchCount;
+}
+
+void ParallelFor(int count, int grain, ParallelForFunc fn, void *context) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    // The game's pools are smaller than JOB_GRAIN, so cut them into one
+    // share per thread rather than leaving them whole on the caller
+    int share = (count + workerCount) / (workerCount + 1);
+    int floor = grain < JOB_MIN_GRAIN ? grain : JOB_MIN_GRAIN;
+    if (share < grain) grain = share > floor ? share : floor;
+    if (workerCount == 0 || count <= grain) {
+        fn(context, 0, count);
+        return;
+    }
+
+    pthread_mutex_lock(&jobLock);
+    batch = (JobBatch){
+        .fn = fn,
+        .context = context,
+        .count = count,
+        .grain = grain,
+        .chunkCount = (count + grain - 1) / grain,
+        .nextChunk = 0
+    };
+    busyWorkers = workerCount;
+    generation++;
+    dispatchCount++;
+    pthread_cond_broadcast(&jobWake);
+    pthread_mutex_unlock(&jobLock);
+
+    // The caller works too instead of idling until the join
+    RunChunks();
+
+    pthread_mutex_lock(&jobLock);
+    while (busyWorkers > 0) pthread_cond_wait(&jobDone, &jobLock);
+    pthread_mutex_unlock(&jobLock);
+}
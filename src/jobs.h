@@ -0,0 +1,41 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+// -----------------------------------------------------------------------------
+// Worker pool with a chunked parallel-for
+// -----------------------------------------------------------------------------
+// A fixed set of worker threads sleeps until ParallelFor hands them a range.
+// The range is cut into chunks of `grain` items that the workers and the
+// calling thread claim from a shared counter until none are left; the call
+// returns once every chunk is done, so results are joined before the caller
+// moves on (and before anything is drawn).
+//
+// Only use it for element-wise passes where item i reads and writes slot i
+// alone. Then the output does not depend on which thread ran which chunk,
+// and a threaded run is bit-identical to a serial one for the same seed.
+// Anything order-dependent (RNG draws, compaction) stays on the caller.
+
+#define JOB_MAX_WORKERS 15      // Plus the calling thread
+#define JOB_WORKERS_AUTO (-1)   // One per online core, minus the caller
+#define JOB_GRAIN 4096          // Most items per chunk for the entity updates
+#define JOB_MIN_GRAIN 64        // Fewest items worth handing to another thread
+
+typedef void (*ParallelForFunc)(void *context, int start, int end);
+
+// Start the pool. workerCount 0 keeps everything on the calling thread;
+// JOB_WORKERS_AUTO sizes it from the machine. ParallelFor is valid (and
+// serial) before this is called.
+void InitJobSystem(int workerCount);
+void ShutdownJobSystem(void);
+int GetJobWorkerCount(void);
+
+// Run fn(context, start, end) over [0, count) in chunks of at most grain
+// items. A range with fewer chunks than threads is cut into one share per
+// thread, down to JOB_MIN_GRAIN (or grain, if smaller); ranges too small to
+// split run inline on the caller.
+void ParallelFor(int count, int grain, ParallelForFunc fn, void *context);
+// ParallelFor calls that were split across the workers, since the last
+// InitJobSystem
+unsigned long long GetJobDispatchCount(void);
+
+#endif // JOBS_H
@@ -0,0 +1,371 @@
+#include "kernels.h"
+#include "config.h"
+
+#include <stdbool.h>
+#include <math.h>
+
+#if defined(SHMUP_HAVE_AVX2)
+#include <immintrin.h>
+#elif defined(SHMUP_HAVE_SSE2)
+#include <emmintrin.h>
+#endif
+
+// Stands in for an infinite slab entry/exit time along an axis the point
+// does not move on
+#define SWEEP_FAR 1e30f
+
+// -----------------------------------------------------------------------------
+// Scalar path
+// -----------------------------------------------------------------------------
+// The sweeps below evaluate the same expressions in the same order as the
+// vector paths, so every path reports bit-identical times of impact.
+void IntegrateBulletsScalar(float *x, float *y, const float *vx, const float *vy,
+                            unsigned char *offscreen, int n, float dt) {
+    for (int i = 0; i < n; i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        offscreen[i] = x[i] < -BULLET_CULL_MARGIN || x[i] > SCREEN_WIDTH + BULLET_CULL_MARGIN ||
+                       y[i] < -BULLET_CULL_MARGIN || y[i] > SCREEN_HEIGHT + BULLET_CULL_MARGIN;
+    }
+}
+
+static void KeepEarliest(float t, int id, float *toi, int *hit) {
+    if (t < *toi || (t == *toi && id < *hit)) {
+        *toi = t;
+        *hit = id;
+    }
+}
+
+void SweepCircleScalar(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                       const SweepTarget *target, float *toi, int *hit) {
+    float rr = target->radius * target->radius;
+    for (int i = 0; i < n; i++) {
+        // Relative to the target the point starts at f and moves by d;
+        // the first t with |f + t d| = radius is the smaller root
+        float dx = vx[i] * dt - target->dx;
+        float dy = vy[i] * dt - target->dy;
+        float fx = x[i] - target->x - dx;
+        float fy = y[i] - target->y - dy;
+        float a = dx * dx + dy * dy;
+        float b = fx * dx + fy * dy;
+        float c = fx * fx + fy * fy - rr;
+        float disc = b * b - a * c;
+        float t;
+        if (c <= 0.0f) {
+            t = 0.0f; // Already touching when the tick starts
+        } else if (disc >= 0.0f && b < 0.0f) {
+            t = (-b - sqrtf(disc)) / a;
+        } else {
+            continue; // Moving away, or passing wide
+        }
+        if (t <= 1.0f) KeepEarliest(t, target->id, toi + i, hit + i);
+    }
+}
+
+// When |f + t d| <= half along one axis: the slab entry and exit times
+static void SlabInterval(float f, float d, float half, float *enter, float *leave) {
+    if (d == 0.0f) {
+        bool inside = f >= -half && f <= half;
+        *enter = inside ? -SWEEP_FAR : SWEEP_FAR;
+        *leave = inside ? SWEEP_FAR : -SWEEP_FAR;
+        return;
+    }
+    float t1 = (-half - f) / d;
+    float t2 = (half - f) / d;
+    *enter = t1 < t2 ? t1 : t2;
+    *leave = t1 > t2 ? t1 : t2;
+}
+
+void SweepBoxScalar(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                    const SweepTarget *target, float *toi, int *hit) {
+    for (int i = 0; i < n; i++) {
+        float dx = vx[i] * dt - target->dx;
+        float dy = vy[i] * dt - target->dy;
+        float fx = x[i] - target->x - dx;
+        float fy = y[i] - target->y - dy;
+        float enterX, leaveX, enterY, leaveY;
+        SlabInterval(fx, dx, target->halfWidth, &enterX, &leaveX);
+        SlabInterval(fy, dy, target->halfHeight, &enterY, &leaveY);
+        float enter = enterX > enterY ? enterX : enterY;
+        float leave = leaveX < leaveY ? leaveX : leaveY;
+        if (enter <= leave && leave >= 0.0f && enter <= 1.0f) {
+            KeepEarliest(enter > 0.0f ? enter : 0.0f, target->id, toi + i, hit + i);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// SSE2 path (4 lanes)
+// -----------------------------------------------------------------------------
+#if defined(SHMUP_HAVE_SSE2)
+// Expand the low 4 bits of a movemask result into 4 mask bytes
+static void StoreMask4(unsigned char *out, int bits) {
+    out[0] = bits & 1;
+    out[1] = (bits >> 1) & 1;
+    out[2] = (bits >> 2) & 1;
+    out[3] = (bits >> 3) & 1;
+}
+
+void IntegrateBulletsSse2(float *x, float *y, const float *vx, const float *vy,
+                          unsigned char *offscreen, int n, float dt) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 minXY = _mm_set1_ps(-BULLET_CULL_MARGIN);
+    const __m128 maxX = _mm_set1_ps(SCREEN_WIDTH + BULLET_CULL_MARGIN);
+    const __m128 maxY = _mm_set1_ps(SCREEN_HEIGHT + BULLET_CULL_MARGIN);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), vdt));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), vdt));
+        _mm_storeu_ps(x + i, px);
+        _mm_storeu_ps(y + i, py);
+        __m128 out = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(px, minXY), _mm_cmpgt_ps(px, maxX)),
+                               _mm_or_ps(_mm_cmplt_ps(py, minXY), _mm_cmpgt_ps(py, maxY)));
+        StoreMask4(offscreen + i, _mm_movemask_ps(out));
+    }
+    IntegrateBulletsScalar(x + i, y + i, vx + i, vy + i, offscreen + i, n - i, dt);
+}
+
+// mask ? a : b, lane by lane
+static __m128 Select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static void KeepEarliest4(__m128 found, __m128 t, __m128i id, float *toi, int *hit) {
+    __m128 best = _mm_loadu_ps(toi);
+    __m128i bestId = _mm_loadu_si128((const __m128i *)hit);
+    __m128 earlier = _mm_or_ps(_mm_cmplt_ps(t, best),
+                               _mm_and_ps(_mm_cmpeq_ps(t, best), _mm_castsi128_ps(_mm_cmplt_epi32(id, bestId))));
+    __m128 take = _mm_and_ps(found, earlier);
+    _mm_storeu_ps(toi, Select4(take, t, best));
+    _mm_storeu_si128((__m128i *)hit,
+                     _mm_castps_si128(Select4(take, _mm_castsi128_ps(id), _mm_castsi128_ps(bestId))));
+}
+
+void SweepCircleSse2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                     const SweepTarget *target, float *toi, int *hit) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 tx = _mm_set1_ps(target->x);
+    const __m128 ty = _mm_set1_ps(target->y);
+    const __m128 tdx = _mm_set1_ps(target->dx);
+    const __m128 tdy = _mm_set1_ps(target->dy);
+    const __m128 rr = _mm_set1_ps(target->radius * target->radius);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i id = _mm_set1_epi32(target->id);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), vdt), tdx);
+        __m128 dy = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), vdt), tdy);
+        __m128 fx = _mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(x + i), tx), dx);
+        __m128 fy = _mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(y + i), ty), dy);
+        __m128 a = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 b = _mm_add_ps(_mm_mul_ps(fx, dx), _mm_mul_ps(fy, dy));
+        __m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fy, fy)), rr);
+        __m128 disc = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, c));
+        __m128 inside = _mm_cmple_ps(c, zero);
+        __m128 entering = _mm_and_ps(_mm_cmplt_ps(b, zero), _mm_cmpge_ps(disc, zero));
+        // Lanes that miss may divide by zero; they are masked out below
+        __m128 root = _mm_div_ps(_mm_sub_ps(_mm_sub_ps(zero, b), _mm_sqrt_ps(_mm_max_ps(disc, zero))), a);
+        __m128 t = _mm_andnot_ps(inside, root);
+        __m128 found = _mm_and_ps(_mm_or_ps(inside, entering), _mm_cmple_ps(t, one));
+        KeepEarliest4(found, t, id, toi + i, hit + i);
+    }
+    SweepCircleScalar(x + i, y + i, vx + i, vy + i, n - i, dt, target, toi + i, hit + i);
+}
+
+static void SlabInterval4(__m128 f, __m128 d, __m128 half, __m128 negHalf, __m128 *enter, __m128 *leave) {
+    const __m128 never = _mm_set1_ps(SWEEP_FAR);
+    const __m128 always = _mm_set1_ps(-SWEEP_FAR);
+    __m128 t1 = _mm_div_ps(_mm_sub_ps(negHalf, f), d);
+    __m128 t2 = _mm_div_ps(_mm_sub_ps(half, f), d);
+    __m128 still = _mm_cmpeq_ps(d, _mm_setzero_ps());
+    __m128 inside = _mm_and_ps(_mm_cmpge_ps(f, negHalf), _mm_cmple_ps(f, half));
+    *enter = Select4(still, Select4(inside, always, never), _mm_min_ps(t1, t2));
+    *leave = Select4(still, Select4(inside, never, always), _mm_max_ps(t1, t2));
+}
+
+void SweepBoxSse2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                  const SweepTarget *target, float *toi, int *hit) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 tx = _mm_set1_ps(target->x);
+    const __m128 ty = _mm_set1_ps(target->y);
+    const __m128 tdx = _mm_set1_ps(target->dx);
+    const __m128 tdy = _mm_set1_ps(target->dy);
+    const __m128 halfW = _mm_set1_ps(target->halfWidth);
+    const __m128 halfH = _mm_set1_ps(target->halfHeight);
+    const __m128 negHalfW = _mm_set1_ps(-target->halfWidth);
+    const __m128 negHalfH = _mm_set1_ps(-target->halfHeight);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i id = _mm_set1_epi32(target->id);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), vdt), tdx);
+        __m128 dy = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), vdt), tdy);
+        __m128 fx = _mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(x + i), tx), dx);
+        __m128 fy = _mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(y + i), ty), dy);
+        __m128 enterX, leaveX, enterY, leaveY;
+        SlabInterval4(fx, dx, halfW, negHalfW, &enterX, &leaveX);
+        SlabInterval4(fy, dy, halfH, negHalfH, &enterY, &leaveY);
+        __m128 enter = _mm_max_ps(enterX, enterY);
+        __m128 leave = _mm_min_ps(leaveX, leaveY);
+        __m128 found = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(enter, leave), _mm_cmpge_ps(leave, zero)),
+                                  _mm_cmple_ps(enter, one));
+        KeepEarliest4(found, _mm_max_ps(enter, zero), id, toi + i, hit + i);
+    }
+    SweepBoxScalar(x + i, y + i, vx + i, vy + i, n - i, dt, target, toi + i, hit + i);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// AVX2 path (8 lanes)
+// -----------------------------------------------------------------------------
+#if defined(SHMUP_HAVE_AVX2)
+static void StoreMask8(unsigned char *out, int bits) {
+    for (int k = 0; k < 8; k++) {
+        out[k] = (bits >> k) & 1;
+    }
+}
+
+void IntegrateBulletsAvx2(float *x, float *y, const float *vx, const float *vy,
+                          unsigned char *offscreen, int n, float dt) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 minXY = _mm256_set1_ps(-BULLET_CULL_MARGIN);
+    const __m256 maxX = _mm256_set1_ps(SCREEN_WIDTH + BULLET_CULL_MARGIN);
+    const __m256 maxY = _mm256_set1_ps(SCREEN_HEIGHT + BULLET_CULL_MARGIN);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt));
+        __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt));
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+        __m256 out = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(px, minXY, _CMP_LT_OQ), _mm256_cmp_ps(px, maxX, _CMP_GT_OQ)),
+                                  _mm256_or_ps(_mm256_cmp_ps(py, minXY, _CMP_LT_OQ), _mm256_cmp_ps(py, maxY, _CMP_GT_OQ)));
+        StoreMask8(offscreen + i, _mm256_movemask_ps(out));
+    }
+    IntegrateBulletsScalar(x + i, y + i, vx + i, vy + i, offscreen + i, n - i, dt);
+}
+
+static void KeepEarliest8(__m256 found, __m256 t, __m256i id, float *toi, int *hit) {
+    __m256 best = _mm256_loadu_ps(toi);
+    __m256i bestId = _mm256_loadu_si256((const __m256i *)hit);
+    __m256 earlier = _mm256_or_ps(_mm256_cmp_ps(t, best, _CMP_LT_OQ),
+                                  _mm256_and_ps(_mm256_cmp_ps(t, best, _CMP_EQ_OQ),
+                                                _mm256_castsi256_ps(_mm256_cmpgt_epi32(bestId, id))));
+    __m256 take = _mm256_and_ps(found, earlier);
+    _mm256_storeu_ps(toi, _mm256_blendv_ps(best, t, take));
+    _mm256_storeu_si256((__m256i *)hit, _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestId),
+                                                                              _mm256_castsi256_ps(id), take)));
+}
+
+void SweepCircleAvx2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                     const SweepTarget *target, float *toi, int *hit) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 tx = _mm256_set1_ps(target->x);
+    const __m256 ty = _mm256_set1_ps(target->y);
+    const __m256 tdx = _mm256_set1_ps(target->dx);
+    const __m256 tdy = _mm256_set1_ps(target->dy);
+    const __m256 rr = _mm256_set1_ps(target->radius * target->radius);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i id = _mm256_set1_epi32(target->id);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt), tdx);
+        __m256 dy = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt), tdy);
+        __m256 fx = _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(x + i), tx), dx);
+        __m256 fy = _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(y + i), ty), dy);
+        __m256 a = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 b = _mm256_add_ps(_mm256_mul_ps(fx, dx), _mm256_mul_ps(fy, dy));
+        __m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(fx, fx), _mm256_mul_ps(fy, fy)), rr);
+        __m256 disc = _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(a, c));
+        __m256 inside = _mm256_cmp_ps(c, zero, _CMP_LE_OQ);
+        __m256 entering = _mm256_and_ps(_mm256_cmp_ps(b, zero, _CMP_LT_OQ), _mm256_cmp_ps(disc, zero, _CMP_GE_OQ));
+        __m256 root = _mm256_div_ps(_mm256_sub_ps(_mm256_sub_ps(zero, b), _mm256_sqrt_ps(_mm256_max_ps(disc, zero))), a);
+        __m256 t = _mm256_andnot_ps(inside, root);
+        __m256 found = _mm256_and_ps(_mm256_or_ps(inside, entering), _mm256_cmp_ps(t, one, _CMP_LE_OQ));
+        KeepEarliest8(found, t, id, toi + i, hit + i);
+    }
+    SweepCircleScalar(x + i, y + i, vx + i, vy + i, n - i, dt, target, toi + i, hit + i);
+}
+
+static void SlabInterval8(__m256 f, __m256 d, __m256 half, __m256 negHalf, __m256 *enter, __m256 *leave) {
+    const __m256 never = _mm256_set1_ps(SWEEP_FAR);
+    const __m256 always = _mm256_set1_ps(-SWEEP_FAR);
+    __m256 t1 = _mm256_div_ps(_mm256_sub_ps(negHalf, f), d);
+    __m256 t2 = _mm256_div_ps(_mm256_sub_ps(half, f), d);
+    __m256 still = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    __m256 inside = _mm256_and_ps(_mm256_cmp_ps(f, negHalf, _CMP_GE_OQ), _mm256_cmp_ps(f, half, _CMP_LE_OQ));
+    *enter = _mm256_blendv_ps(_mm256_min_ps(t1, t2), _mm256_blendv_ps(never, always, inside), still);
+    *leave = _mm256_blendv_ps(_mm256_max_ps(t1, t2), _mm256_blendv_ps(always, never, inside), still);
+}
+
+void SweepBoxAvx2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                  const SweepTarget *target, float *toi, int *hit) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 tx = _mm256_set1_ps(target->x);
+    const __m256 ty = _mm256_set1_ps(target->y);
+    const __m256 tdx = _mm256_set1_ps(target->dx);
+    const __m256 tdy = _mm256_set1_ps(target->dy);
+    const __m256 halfW = _mm256_set1_ps(target->halfWidth);
+    const __m256 halfH = _mm256_set1_ps(target->halfHeight);
+    const __m256 negHalfW = _mm256_set1_ps(-target->halfWidth);
+    const __m256 negHalfH = _mm256_set1_ps(-target->halfHeight);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i id = _mm256_set1_epi32(target->id);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt), tdx);
+        __m256 dy = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt), tdy);
+        __m256 fx = _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(x + i), tx), dx);
+        __m256 fy = _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(y + i), ty), dy);
+        __m256 enterX, leaveX, enterY, leaveY;
+        SlabInterval8(fx, dx, halfW, negHalfW, &enterX, &leaveX);
+        SlabInterval8(fy, dy, halfH, negHalfH, &enterY, &leaveY);
+        __m256 enter = _mm256_max_ps(enterX, enterY);
+        __m256 leave = _mm256_min_ps(leaveX, leaveY);
+        __m256 found = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(enter, leave, _CMP_LE_OQ),
+                                                   _mm256_cmp_ps(leave, zero, _CMP_GE_OQ)),
+                                     _mm256_cmp_ps(enter, one, _CMP_LE_OQ));
+        KeepEarliest8(found, _mm256_max_ps(enter, zero), id, toi + i, hit + i);
+    }
+    SweepBoxScalar(x + i, y + i, vx + i, vy + i, n - i, dt, target, toi + i, hit + i);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Compile-time dispatch
+// -----------------------------------------------------------------------------
+void IntegrateBullets(float *x, float *y, const float *vx, const float *vy,
+                      unsigned char *offscreen, int n, float dt) {
+#if defined(SHMUP_HAVE_AVX2)
+    IntegrateBulletsAvx2(x, y, vx, vy, offscreen, n, dt);
+#elif defined(SHMUP_HAVE_SSE2)
+    IntegrateBulletsSse2(x, y, vx, vy, offscreen, n, dt);
+#else
+    IntegrateBulletsScalar(x, y, vx, vy, offscreen, n, dt);
+#endif
+}
+
+void SweepCircle(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                 const SweepTarget *target, float *toi, int *hit) {
+#if defined(SHMUP_HAVE_AVX2)
+    SweepCircleAvx2(x, y, vx, vy, n, dt, target, toi, hit);
+#elif defined(SHMUP_HAVE_SSE2)
+    SweepCircleSse2(x, y, vx, vy, n, dt, target, toi, hit);
+#else
+    SweepCircleScalar(x, y, vx, vy, n, dt, target, toi, hit);
+#endif
+}
+
+void SweepBox(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+              const SweepTarget *target, float *toi, int *hit) {
+#if defined(SHMUP_HAVE_AVX2)
+    SweepBoxAvx2(x, y, vx, vy, n, dt, target, toi, hit);
+#elif defined(SHMUP_HAVE_SSE2)
+    SweepBoxSse2(x, y, vx, vy, n, dt, target, toi, hit);
+#else
+    SweepBoxScalar(x, y, vx, vy, n, dt, target, toi, hit);
+#endif
+}
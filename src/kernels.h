@@ -0,0 +1,87 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+// -----------------------------------------------------------------------------
+// Integration kernels over structure-of-arrays entity storage
+// -----------------------------------------------------------------------------
+// Each kernel advances n entities by one step and writes offscreen[i] = 1 for
+// every entity that left the play field, 0 otherwise. Callers then do their
+// own compaction or respawn pass over the mask.
+//
+// The widest path the compiler targets is picked at compile time:
+// AVX2 (-mavx2), then SSE2 (baseline on x86-64), then plain C.
+// Define SHMUP_NO_SIMD to force the scalar path.
+
+#if !defined(SHMUP_NO_SIMD) && defined(__AVX2__)
+#define SHMUP_HAVE_AVX2 1
+#endif
+#if !defined(SHMUP_NO_SIMD) && defined(__SSE2__)
+#define SHMUP_HAVE_SSE2 1
+#endif
+
+#if defined(SHMUP_HAVE_AVX2)
+#define SIMD_PATH_NAME "avx2"
+#elif defined(SHMUP_HAVE_SSE2)
+#define SIMD_PATH_NAME "sse2"
+#else
+#define SIMD_PATH_NAME "scalar"
+#endif
+
+// Bullets: x += vx * dt, y += vy * dt, offscreen when outside the play field
+// grown by BULLET_CULL_MARGIN on every side
+#define BULLET_CULL_MARGIN 16.0f
+void IntegrateBullets(float *x, float *y, const float *vx, const float *vy,
+                      unsigned char *offscreen, int n, float dt);
+
+// Individual paths, exposed so the benchmark can compare them side by side
+void IntegrateBulletsScalar(float *x, float *y, const float *vx, const float *vy,
+                            unsigned char *offscreen, int n, float dt);
+#if defined(SHMUP_HAVE_SSE2)
+void IntegrateBulletsSse2(float *x, float *y, const float *vx, const float *vy,
+                          unsigned char *offscreen, int n, float dt);
+#endif
+#if defined(SHMUP_HAVE_AVX2)
+void IntegrateBulletsAvx2(float *x, float *y, const float *vx, const float *vy,
+                          unsigned char *offscreen, int n, float dt);
+#endif
+
+// Swept tests of n moving points against one moving target over a tick of
+// dt. Point i ends the tick at (x[i], y[i]) after moving by (vx[i], vy[i]) * dt;
+// the target ends at (x, y) after moving by (dx, dy). Where the point's
+// segment, taken relative to the target, first touches it at a fraction t
+// in [0, 1] of the tick, and t is earlier than toi[i] (ties go to the lower
+// id), toi[i] = t and hit[i] = target id. Callers start toi at SWEEP_MISS.
+// Points are tested as lines: fold the point's radius into the target's.
+#define SWEEP_MISS 2.0f
+
+typedef struct SweepTarget {
+    float x, y;                 // Position at the end of the tick
+    float dx, dy;               // Distance moved over the tick
+    float radius;               // Circles
+    float halfWidth, halfHeight; // Axis-aligned boxes, centered on (x, y)
+    int id;
+} SweepTarget;
+
+void SweepCircle(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                 const SweepTarget *target, float *toi, int *hit);
+void SweepBox(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+              const SweepTarget *target, float *toi, int *hit);
+
+void SweepCircleScalar(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                       const SweepTarget *target, float *toi, int *hit);
+void SweepBoxScalar(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                    const SweepTarget *target, float *toi, int *hit);
+#if defined(SHMUP_HAVE_SSE2)
+void SweepCircleSse2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                     const SweepTarget *target, float *toi, int *hit);
+void SweepBoxSse2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                  const SweepTarget *target, float *toi, int *hit);
+#endif
+#if defined(SHMUP_HAVE_AVX2)
+void SweepCircleAvx2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                     const SweepTarget *target, float *toi, int *hit);
+void SweepBoxAvx2(const float *x, const float *y, const float *vx, const float *vy, int n, float dt,
+                  const SweepTarget *target, float *toi, int *hit);
+#endif
+
+#endif // KERNELS_H
@@ -0,0 +1,132 @@
+#include "particles.h"
+
+#include <math.h>
+
+#include "atlas.h"
+#include "jobs.h"
+#include "rng.h"
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+ParticlePool particles;
+
+// Effects are cosmetic: their own stream keeps them from shifting any
+// gameplay random numbers
+static Rng particleRng;
+
+// -----------------------------------------------------------------------------
+// Particle Functions
+// -----------------------------------------------------------------------------
+void InitParticles(uint64_t seed) {
+    particles.tail = 0;
+    particles.count = 0;
+    RngSeed(&particleRng, seed ^ 0x9e3779b97f4a7c15ULL);
+}
+
+void SpawnParticle(Vector2 position, Vector2 velocity, float life, float size, Color color) {
+    int i = (particles.tail + particles.count) & PARTICLE_MASK;
+    if (particles.count == MAX_PARTICLES) {
+        particles.tail = (particles.tail + 1) & PARTICLE_MASK; // Full: the oldest gives way
+    } else {
+        particles.count++;
+    }
+
+    particles.x[i] = position.x;
+    particles.y[i] = position.y;
+    particles.vx[i] = velocity.x;
+    particles.vy[i] = velocity.y;
+    particles.life[i] = life;
+    particles.invLife[i] = 1.0f / life;
+    particles.size[i] = size;
+    particles.color[i] = color;
+}
+
+void SpawnExplosion(Vector2 position, int count, Color color) {
+    for (int p = 0; p < count; p++) {
+        float angle = RngRange(&particleRng, 0.0f, 2.0f * PI);
+        float speed = RngRange(&particleRng, 40.0f, 260.0f);
+        Vector2 velocity = { cosf(angle) * speed, sinf(angle) * speed };
+        SpawnParticle(position, velocity, RngRange(&particleRng, 0.4f, 0.9f),
+                      RngRange(&particleRng, 0.6f, 1.4f), color);
+    }
+}
+
+void SpawnEngineTrail(Vector2 position) {
+    for (int p = 0; p < ENGINE_TRAIL_PARTICLES; p++) {
+        Vector2 velocity = { RngRange(&particleRng, -20.0f, 20.0f), RngRange(&particleRng, 120.0f, 200.0f) };
+        SpawnParticle(position, velocity, RngRange(&particleRng, 0.2f, 0.35f),
+                      RngRange(&particleRng, 0.5f, 0.9f), ENGINE_TRAIL_COLOR);
+    }
+}
+
+typedef struct ParticleStep {
+    int first; // Ring slot of range index 0
+    float dt;
+    float damping;
+} ParticleStep;
+
+static void IntegrateParticleRange(void *context, int start, int end) {
+    // Straight-line body over contiguous slots with no per-particle test,
+    // so the compiler can vectorize it
+    const ParticleStep *step = context;
+    float dt = step->dt;
+    float damping = step->damping;
+    for (int i = step->first + start; i < step->first + end; i++) {
+        particles.x[i] += particles.vx[i] * dt;
+        particles.y[i] += particles.vy[i] * dt;
+        particles.vx[i] *= damping;
+        particles.vy[i] *= damping;
+        particles.life[i] -= dt;
+    }
+}
+
+void UpdateParticles(float deltaTime) {
+    // The live window wraps at most once, so it is at most two spans
+    ParticleStep step = { particles.tail, deltaTime, 1.0f - PARTICLE_DRAG * deltaTime };
+    int end = particles.tail + particles.count;
+    if (end <= MAX_PARTICLES) {
+        ParallelFor(particles.count, JOB_GRAIN, IntegrateParticleRange, &step);
+    } else {
+        ParallelFor(MAX_PARTICLES - particles.tail, JOB_GRAIN, IntegrateParticleRange, &step);
+        step.first = 0;
+        ParallelFor(end - MAX_PARTICLES, JOB_GRAIN, IntegrateParticleRange, &step);
+    }
+
+    // Retire expired particles from the old end of the ring
+    while (particles.count > 0 && particles.life[particles.tail] <= 0.0f) {
+        particles.tail = (particles.tail + 1) & PARTICLE_MASK;
+        particles.count--;
+    }
+}
+
+int CountActiveParticles(void) {
+    return particles.count;
+}
+
+// -----------------------------------------------------------------------------
+// Particle Rendering
+// -----------------------------------------------------------------------------
+void DrawParticles(const ParticlePool *pool, float alpha) {
+    if (!atlas.loaded) return;
+
+    // Same batching as the bullets: one atlas texture for every quad. The
+    // sprite shrinks and fades out over the particle's life.
+    float lag = (1.0f - alpha) * SIM_DT;
+    Rectangle frame = atlas.frames[SPRITE_PARTICLE];
+    for (int n = 0; n < pool->count; n++) {
+        int i = (pool->tail + n) & PARTICLE_MASK;
+        float fade = pool->life[i] * pool->invLife[i];
+        if (fade <= 0.0f) continue; // Expired but younger than the tail
+
+        float size = frame.width * pool->size[i] * (0.5f + 0.5f * fade);
+        Rectangle dest = {
+            pool->x[i] - pool->vx[i] * lag - size / 2.0f,
+            pool->y[i] - pool->vy[i] * lag - size / 2.0f,
+            size, size
+        };
+        Color color = pool->color[i];
+        color.a = (unsigned char)(color.a * fade);
+        DrawTexturePro(atlas.texture, frame, dest, (Vector2){ 0, 0 }, 0.0f, color);
+    }
+}
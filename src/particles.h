@@ -0,0 +1,67 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"
+#include "config.h"
+#include <stdint.h>
+
+#ifndef MAX_PARTICLES
+#define MAX_PARTICLES 65536 // Ring capacity, a power of two; override with -DMAX_PARTICLES=N
+#endif
+#define PARTICLE_MASK (MAX_PARTICLES - 1)
+#define PARTICLE_RADIUS 3   // Atlas sprite radius; each particle scales it by its size
+#define PARTICLE_DRAG 1.5f  // Fraction of velocity lost per second
+
+#define EXPLOSION_PARTICLES 48
+#define EXPLOSION_COLOR (Color){ 255, 170, 60, 255 }
+#define ENGINE_TRAIL_PARTICLES 2 // Per simulation tick
+#define ENGINE_TRAIL_COLOR (Color){ 120, 190, 255, 255 }
+
+#if (MAX_PARTICLES & PARTICLE_MASK) != 0
+#error "MAX_PARTICLES must be a power of two"
+#endif
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+// Structure-of-arrays ring buffer. Live particles are the slots
+// [tail, tail + count) modulo MAX_PARTICLES, oldest first. Spawning writes
+// at the head and, when the ring is full, overwrites the oldest particle,
+// so memory is bounded and spawning never fails. The update integrates
+// every slot in the window without testing for death; only the oldest end
+// is retired each tick, and a particle that dies before an older one waits
+// in the window with life <= 0 and is not drawn.
+typedef struct ParticlePool {
+    float x[MAX_PARTICLES];
+    float y[MAX_PARTICLES];
+    float vx[MAX_PARTICLES];
+    float vy[MAX_PARTICLES];
+    float life[MAX_PARTICLES];    // Seconds left, <= 0 once expired
+    float invLife[MAX_PARTICLES]; // 1 / initial life, for the fade
+    float size[MAX_PARTICLES];    // Scale of the PARTICLE_RADIUS sprite
+    Color color[MAX_PARTICLES];
+    int tail;                     // Oldest live slot
+    int count;
+} ParticlePool;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern ParticlePool particles;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitParticles(uint64_t seed);
+void SpawnParticle(Vector2 position, Vector2 velocity, float life, float size, Color color);
+void SpawnExplosion(Vector2 position, int count, Color color);
+void SpawnEngineTrail(Vector2 position);
+void UpdateParticles(float deltaTime);
+int CountActiveParticles(void);
+
+// Draw from the live pool or a snapshot copy of it (see snapshot.h). alpha
+// in [0, 1] is how far the render time sits between the previous and the
+// current simulation tick
+void DrawParticles(const ParticlePool *pool, float alpha);
+
+#endif // PARTICLES_H
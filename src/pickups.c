@@ -0,0 +1,52 @@
+#include "pickups.h"
+
+#include "atlas.h"
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct PickupCollection {
+    Vector2 ship;
+    int collected; // Added to atomically from the workers
+} PickupCollection;
+
+// -----------------------------------------------------------------------------
+// Systems
+// -----------------------------------------------------------------------------
+static void CollectSystem(void *context, EcsChunkView *chunk) {
+    PickupCollection *collection = context;
+    const Vector2 *position = chunk->column[COMPONENT_POSITION];
+    const float *reach = chunk->column[COMPONENT_PICKUP];
+    int collected = 0;
+    for (int i = 0; i < chunk->count; i++) {
+        float dx = position[i].x - collection->ship.x;
+        float dy = position[i].y - collection->ship.y;
+        if (dx * dx + dy * dy > reach[i] * reach[i]) continue;
+        DestroyEntityLater(chunk->entities[i]);
+        collected++;
+    }
+    if (collected > 0) __atomic_fetch_add(&collection->collected, collected, __ATOMIC_RELAXED);
+}
+
+// -----------------------------------------------------------------------------
+// Pickup Functions
+// -----------------------------------------------------------------------------
+Entity SpawnPickup(Vector2 position) {
+    Entity pickup = CreateEntity(PICKUP_COMPONENTS);
+    if (pickup == ECS_NULL_ENTITY) return pickup; // World full, no drop
+
+    *(Vector2 *)GetComponent(pickup, COMPONENT_POSITION) = position;
+    *(Vector2 *)GetComponent(pickup, COMPONENT_PREVIOUS) = position;
+    *(Vector2 *)GetComponent(pickup, COMPONENT_VELOCITY) = (Vector2){ 0.0f, PICKUP_FALL_SPEED };
+    *(float *)GetComponent(pickup, COMPONENT_LIFETIME) = PICKUP_LIFETIME;
+    *(EcsSprite *)GetComponent(pickup, COMPONENT_SPRITE) = (EcsSprite){ SPRITE_PICKUP, PICKUP_COLOR };
+    *(float *)GetComponent(pickup, COMPONENT_PICKUP) = PICKUP_COLLECT_RADIUS;
+    return pickup;
+}
+
+int CollectPickups(Vector2 shipCenter) {
+    PickupCollection collection = { shipCenter, 0 };
+    RunSystem(&world.storage, ECS_MASK(COMPONENT_POSITION) | ECS_MASK(COMPONENT_PICKUP), CollectSystem, &collection);
+    FlushDestroyedEntities();
+    return collection.collected;
+}
@@ -0,0 +1,32 @@
+#ifndef PICKUPS_H
+#define PICKUPS_H
+
+#include "raylib.h"
+#include "ecs.h"
+
+// -----------------------------------------------------------------------------
+// Pickups
+// -----------------------------------------------------------------------------
+// Dropped by destroyed enemies, they drift down the field until the ship
+// flies over them or they expire. They are plain entities: movement, expiry,
+// culling and drawing come from the shared systems, and only collection is
+// specific to them.
+
+#define PICKUP_RADIUS 4            // Atlas sprite radius
+#define PICKUP_COLLECT_RADIUS 24.0f
+#define PICKUP_FALL_SPEED 90.0f
+#define PICKUP_LIFETIME 6.0f
+#define PICKUP_COLOR (Color){ 120, 255, 140, 255 }
+#define PICKUP_COMPONENTS (ECS_MASK(COMPONENT_POSITION) | ECS_MASK(COMPONENT_PREVIOUS) | \
+                           ECS_MASK(COMPONENT_VELOCITY) | ECS_MASK(COMPONENT_LIFETIME) | \
+                           ECS_MASK(COMPONENT_SPRITE) | ECS_MASK(COMPONENT_PICKUP))
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+Entity SpawnPickup(Vector2 position);
+// Remove every pickup within its collect radius of the ship's center;
+// returns how many were collected
+int CollectPickups(Vector2 shipCenter);
+
+#endif // PICKUPS_H
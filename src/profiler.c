@@ -0,0 +1,156 @@
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+
+#include "profiler.h"
+
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "arena.h"
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+static const char *phaseNames[PROFILE_PHASE_COUNT] = {
+    "input", "player", "bullets", "stars", "enemies", "particles", "entities", "draw", "swap", "frame"
+};
+
+static uint64_t phaseStart[PROFILE_PHASE_COUNT];
+static uint64_t phaseTotal[PROFILE_PHASE_COUNT]; // Current frame, ns
+static uint64_t frameStart;
+static bool enabled = false; // Markers are no-ops until InitProfiler, e.g. in headless runs
+
+// Rolling window, one row per frame
+static float window[PROFILE_WINDOW_FRAMES][PROFILE_PHASE_COUNT]; // ms
+static int windowNext = 0;
+static int windowFilled = 0;
+
+// Full-run history for the CSV dump
+static float recorded[PROFILE_MAX_RECORDED_FRAMES][PROFILE_PHASE_COUNT]; // ms
+static int recordedCount = 0;
+
+// -----------------------------------------------------------------------------
+// Timing
+// -----------------------------------------------------------------------------
+uint64_t ProfileNowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void InitProfiler(void) {
+    memset(phaseTotal, 0, sizeof(phaseTotal));
+    windowNext = 0;
+    windowFilled = 0;
+    recordedCount = 0;
+    frameStart = ProfileNowNs();
+    enabled = true;
+}
+
+void ProfileBegin(ProfilePhase phase) {
+    if (!enabled) return;
+    phaseStart[phase] = ProfileNowNs();
+}
+
+void ProfileEnd(ProfilePhase phase) {
+    if (!enabled) return;
+    __atomic_fetch_add(&phaseTotal[phase], ProfileNowNs() - phaseStart[phase], __ATOMIC_RELAXED);
+}
+
+void ProfileFrameEnd(void) {
+    if (!enabled) return;
+    uint64_t now = ProfileNowNs();
+    __atomic_store_n(&phaseTotal[PROFILE_FRAME], now - frameStart, __ATOMIC_RELAXED);
+    frameStart = now;
+
+    // Take and reset each total in one step so time added concurrently by
+    // the simulation thread goes to this frame or the next, never lost
+    float *row = window[windowNext];
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        row[p] = (float)(__atomic_exchange_n(&phaseTotal[p], 0, __ATOMIC_RELAXED) / 1e6);
+    }
+    windowNext = (windowNext + 1) % PROFILE_WINDOW_FRAMES;
+    if (windowFilled < PROFILE_WINDOW_FRAMES) windowFilled++;
+
+    if (recordedCount < PROFILE_MAX_RECORDED_FRAMES) {
+        memcpy(recorded[recordedCount++], row, sizeof(window[0]));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Reporting
+// -----------------------------------------------------------------------------
+static int CompareFloats(const void *a, const void *b) {
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+ProfileStats GetProfileStats(ProfilePhase phase) {
+    ProfileStats stats = { 0 };
+    if (windowFilled == 0) return stats;
+
+    Scratch scratch = BeginScratch();
+    float *sorted = ArenaPushArray(scratch.arena, float, windowFilled);
+    if (sorted == NULL) {
+        EndScratch(scratch);
+        return stats;
+    }
+    double sum = 0.0;
+    for (int i = 0; i < windowFilled; i++) {
+        sorted[i] = window[i][phase];
+        sum += sorted[i];
+    }
+    qsort(sorted, windowFilled, sizeof(float), CompareFloats);
+
+    int p99 = (windowFilled * 99) / 100;
+    if (p99 >= windowFilled) p99 = windowFilled - 1;
+
+    stats.minMs = sorted[0];
+    stats.avgMs = sum / windowFilled;
+    stats.p99Ms = sorted[p99];
+    EndScratch(scratch);
+    return stats;
+}
+
+const char *GetProfilePhaseName(ProfilePhase phase) {
+    return phaseNames[phase];
+}
+
+void DrawProfilerOverlay(int x, int y) {
+    const int lineHeight = 12;
+    DrawRectangle(x - 4, y - 4, 230, lineHeight * (PROFILE_PHASE_COUNT + 1) + 8, Fade(BLACK, 0.6f));
+    DrawText("phase      min    avg    p99 ms", x, y, 10, LIGHTGRAY);
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        ProfileStats stats = GetProfileStats((ProfilePhase)p);
+        DrawText(TextFormat("%-8s %6.2f %6.2f %6.2f", phaseNames[p], stats.minMs, stats.avgMs, stats.p99Ms),
+                 x, y + lineHeight * (p + 1), 10, p == PROFILE_FRAME ? YELLOW : RAYWHITE);
+    }
+}
+
+bool WriteProfileCsv(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "profiler: cannot open %s\n", path);
+        return false;
+    }
+
+    fprintf(file, "frame");
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        fprintf(file, ",%s_ms", phaseNames[p]);
+    }
+    fprintf(file, "\n");
+
+    for (int i = 0; i < recordedCount; i++) {
+        fprintf(file, "%d", i);
+        for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+            fprintf(file, ",%.4f", recorded[i][p]);
+        }
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    return true;
+}
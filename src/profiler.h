@@ -0,0 +1,54 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Per-frame phase profiler
+// -----------------------------------------------------------------------------
+// Wrap each phase of the frame in ProfileBegin/ProfileEnd. A phase may be
+// entered several times per frame (one per simulation tick, say); its times
+// are summed. ProfileFrameEnd closes the frame, pushes the totals into a
+// rolling window for the overlay and records them for the CSV dump.
+//
+// Phases may be timed on another thread (the simulation thread) as long as
+// each phase is only ever timed by one thread. Their totals are added
+// atomically and land in whichever render frame they finished in.
+
+#define PROFILE_WINDOW_FRAMES 240          // Rolling window for min/avg/p99
+#define PROFILE_MAX_RECORDED_FRAMES 36000  // CSV history, 10 minutes at 60 fps
+
+typedef enum ProfilePhase {
+    PROFILE_INPUT = 0,
+    PROFILE_PLAYER,
+    PROFILE_BULLETS,
+    PROFILE_STARS,
+    PROFILE_ENEMIES, // Waves, enemy update and bullet hits
+    PROFILE_PARTICLES,
+    PROFILE_ENTITIES, // Shared entity systems and pickups
+    PROFILE_DRAW,
+    PROFILE_SWAP,   // EndDrawing: buffer swap plus the SetTargetFPS wait
+    PROFILE_FRAME,  // Whole frame, measured between ProfileFrameEnd calls
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+typedef struct ProfileStats {
+    double minMs;
+    double avgMs;
+    double p99Ms;
+} ProfileStats;
+
+void InitProfiler(void);
+void ProfileBegin(ProfilePhase phase);
+void ProfileEnd(ProfilePhase phase);
+void ProfileFrameEnd(void);
+
+ProfileStats GetProfileStats(ProfilePhase phase);
+const char *GetProfilePhaseName(ProfilePhase phase);
+void DrawProfilerOverlay(int x, int y);
+bool WriteProfileCsv(const char *path);
+
+uint64_t ProfileNowNs(void);
+
+#endif // PROFILER_H
@@ -0,0 +1,132 @@
+#include "render_check.h"
+
+#include "raylib.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "config.h"
+#include "bullets.h"
+#include "stars.h"
+#include "atlas.h"
+
+// -----------------------------------------------------------------------------
+// Constants
+// -----------------------------------------------------------------------------
+#define RENDER_CHECK_CHANNEL_TOLERANCE 64 // Max per-channel difference before a pixel counts as mismatched
+#define RENDER_CHECK_MAX_MISMATCH 0.10f   // Max fraction of covered pixels allowed to mismatch
+#define RENDER_CHECK_BULLETS 2000
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static Image RenderToImage(void (*draw)(void)) {
+    RenderTexture2D target = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    BeginTextureMode(target);
+    ClearBackground(BLACK);
+    draw();
+    EndTextureMode();
+
+    Image image = LoadImageFromTexture(target.texture);
+    ImageFlipVertical(&image);
+    UnloadRenderTexture(target);
+    return image;
+}
+
+static bool CompareRenders(const char *name, void (*reference)(void), void (*candidate)(void)) {
+    Image expected = RenderToImage(reference);
+    Image actual = RenderToImage(candidate);
+
+    long covered = 0;
+    long mismatched = 0;
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        for (int x = 0; x < SCREEN_WIDTH; x++) {
+            Color a = GetImageColor(expected, x, y);
+            Color b = GetImageColor(actual, x, y);
+            bool blankA = a.r == 0 && a.g == 0 && a.b == 0;
+            bool blankB = b.r == 0 && b.g == 0 && b.b == 0;
+            if (blankA && blankB) continue;
+
+            covered++;
+            if (abs(a.r - b.r) > RENDER_CHECK_CHANNEL_TOLERANCE ||
+                abs(a.g - b.g) > RENDER_CHECK_CHANNEL_TOLERANCE ||
+                abs(a.b - b.b) > RENDER_CHECK_CHANNEL_TOLERANCE) {
+                mismatched++;
+            }
+        }
+    }
+
+    float fraction = covered > 0 ? (float)mismatched / (float)covered : 0.0f;
+    bool pass = covered > 0 && fraction <= RENDER_CHECK_MAX_MISMATCH;
+    printf("render-check %-8s %s: %ld of %ld covered pixels differ (%.2f%%)\n",
+           name, pass ? "ok  " : "FAIL", mismatched, covered, fraction * 100.0f);
+
+    if (!pass) {
+        // Leave both images behind so the difference can be inspected
+        char path[64];
+        snprintf(path, sizeof(path), "render_check_%s_reference.png", name);
+        ExportImage(expected, path);
+        snprintf(path, sizeof(path), "render_check_%s_batched.png", name);
+        ExportImage(actual, path);
+    }
+
+    UnloadImage(expected);
+    UnloadImage(actual);
+    return pass;
+}
+
+// The check compares fully caught-up frames (alpha = 1)
+static void DrawBulletsChecked(void) { DrawBullets(&bullets, 1.0f); }
+static void DrawBulletsReferenceChecked(void) { DrawBulletsReference(&bullets, 1.0f); }
+static void DrawStarsChecked(void) { DrawStars(stars.layers, 1.0f); }
+static void DrawStarsReferenceChecked(void) { DrawStarsReference(stars.layers, 1.0f); }
+static void DrawStarsBakedChecked(void) { DrawStarsBaked(stars.layers, 1.0f); }
+
+static void SpawnCheckBullets(void) {
+    // Deterministic spread with fractional positions, clipped to the pool size
+    InitBullets();
+    for (int i = 0; i < RENDER_CHECK_BULLETS; i++) {
+        Vector2 position = {
+            (float)((i * 37) % SCREEN_WIDTH) + (float)(i % 4) * 0.25f,
+            (float)((i * 53) % SCREEN_HEIGHT) + (float)(i % 3) * 0.33f
+        };
+        ShootBullet(position);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Entry Point
+// -----------------------------------------------------------------------------
+int RunRenderCheck(void) {
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib shmup render check");
+    if (!IsWindowReady()) {
+        fprintf(stderr, "render-check: could not create a GL context\n");
+        return 2;
+    }
+
+    InitAtlas();
+    SpawnCheckBullets();
+    InitStars(1, MAX_STARS);
+    BakeStarTiles();
+    // Scroll until the slowest layer has wrapped, then one more second so
+    // every layer's tile seam sits on screen rather than at its top edge
+    float slowest = stars.layers[0].speed;
+    for (int l = 1; l < STAR_LAYERS; l++) {
+        if (stars.layers[l].speed < slowest) slowest = stars.layers[l].speed;
+    }
+    int warmupTicks = (int)ceilf(STAR_TILE_HEIGHT / slowest) * SIM_HZ + SIM_HZ;
+    for (int tick = 0; tick < warmupTicks; tick++) {
+        UpdateStars(SIM_DT);
+    }
+
+    bool pass = CompareRenders("bullets", DrawBulletsReferenceChecked, DrawBulletsChecked);
+    pass = CompareRenders("stars", DrawStarsReferenceChecked, DrawStarsChecked) && pass;
+    pass = CompareRenders("startiles", DrawStarsReferenceChecked, DrawStarsBakedChecked) && pass;
+
+    UnloadStarTiles();
+    UnloadAtlas();
+    CloseWindow();
+
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,13 @@
+#ifndef RENDER_CHECK_H
+#define RENDER_CHECK_H
+
+// -----------------------------------------------------------------------------
+// Offscreen render comparison
+// -----------------------------------------------------------------------------
+// Renders a fixed scene once through the reference draw path and once through
+// the batched path into render targets, then compares the two images pixel by
+// pixel. Opens a hidden window for the GL context. Returns a process exit code:
+// 0 when every comparison is within tolerance.
+int RunRenderCheck(void);
+
+#endif // RENDER_CHECK_H
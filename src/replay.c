@@ -0,0 +1,156 @@
+#include "replay.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Constants
+// -----------------------------------------------------------------------------
+#define REPLAY_MAGIC "SHMUPRP1"
+#define REPLAY_MAGIC_SIZE 8
+#define REPLAY_RUN_SIZE 3 // u8 input + u16 run
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static void WriteU16(FILE *file, uint16_t v) {
+    uint8_t bytes[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+static void WriteU64(FILE *file, uint64_t v) {
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = (uint8_t)(v >> (8 * i));
+    fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+static bool ReadU16(FILE *file, uint16_t *v) {
+    uint8_t bytes[2];
+    if (fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes)) return false;
+    *v = (uint16_t)(bytes[0] | bytes[1] << 8);
+    return true;
+}
+
+static bool ReadU64(FILE *file, uint64_t *v) {
+    uint8_t bytes[8];
+    if (fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes)) return false;
+    *v = 0;
+    for (int i = 0; i < 8; i++) *v |= (uint64_t)bytes[i] << (8 * i);
+    return true;
+}
+
+static void FlushRun(InputRecorder *recorder) {
+    if (recorder->run == 0) return;
+    fputc(recorder->bits, recorder->file);
+    WriteU16(recorder->file, recorder->run);
+    recorder->run = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Recording
+// -----------------------------------------------------------------------------
+bool BeginInputRecording(InputRecorder *recorder, const char *path, uint64_t seed, const char *wavePath) {
+    memset(recorder, 0, sizeof(*recorder));
+
+    recorder->file = fopen(path, "wb");
+    if (recorder->file == NULL) {
+        fprintf(stderr, "replay: cannot create %s\n", path);
+        return false;
+    }
+
+    size_t length = strlen(wavePath);
+    if (length >= REPLAY_MAX_PATH) length = REPLAY_MAX_PATH - 1;
+
+    fwrite(REPLAY_MAGIC, 1, REPLAY_MAGIC_SIZE, recorder->file);
+    WriteU64(recorder->file, seed);
+    WriteU16(recorder->file, (uint16_t)length);
+    fwrite(wavePath, 1, length, recorder->file);
+    return true;
+}
+
+void RecordInput(InputRecorder *recorder, PlayerInput input) {
+    if (recorder->file == NULL) return;
+
+    uint8_t bits = PackPlayerInput(input);
+    if (recorder->run > 0 && (bits != recorder->bits || recorder->run == UINT16_MAX)) {
+        FlushRun(recorder);
+    }
+    recorder->bits = bits;
+    recorder->run++;
+    recorder->ticks++;
+}
+
+void EndInputRecording(InputRecorder *recorder) {
+    if (recorder->file == NULL) return;
+    FlushRun(recorder);
+    fclose(recorder->file);
+    recorder->file = NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Playback
+// -----------------------------------------------------------------------------
+bool LoadInputReplay(InputReplay *replay, const char *path) {
+    memset(replay, 0, sizeof(*replay));
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "replay: cannot open %s\n", path);
+        return false;
+    }
+
+    char magic[REPLAY_MAGIC_SIZE];
+    uint16_t length = 0;
+    bool ok = fread(magic, 1, REPLAY_MAGIC_SIZE, file) == REPLAY_MAGIC_SIZE &&
+              memcmp(magic, REPLAY_MAGIC, REPLAY_MAGIC_SIZE) == 0 &&
+              ReadU64(file, &replay->seed) &&
+              ReadU16(file, &length) && length < REPLAY_MAX_PATH &&
+              fread(replay->wavePath, 1, length, file) == length;
+    if (!ok) {
+        fprintf(stderr, "replay: %s is not a replay file\n", path);
+        fclose(file);
+        return false;
+    }
+    replay->wavePath[length] = '\0';
+
+    // The run list is small (3 bytes per input change), so load it whole
+    long bodyStart = ftell(file);
+    fseek(file, 0, SEEK_END);
+    replay->size = ftell(file) - bodyStart;
+    fseek(file, bodyStart, SEEK_SET);
+
+    replay->data = malloc(replay->size > 0 ? replay->size : 1);
+    if (replay->data == NULL || (long)fread(replay->data, 1, replay->size, file) != replay->size) {
+        fprintf(stderr, "replay: cannot read %s\n", path);
+        fclose(file);
+        UnloadInputReplay(replay);
+        return false;
+    }
+    fclose(file);
+
+    replay->size -= replay->size % REPLAY_RUN_SIZE; // Ignore a torn trailing run
+    for (long i = 0; i < replay->size; i += REPLAY_RUN_SIZE) {
+        replay->ticks += replay->data[i + 1] | replay->data[i + 2] << 8;
+    }
+    return true;
+}
+
+bool NextReplayInput(InputReplay *replay, PlayerInput *input) {
+    while (replay->remaining == 0) {
+        if (replay->offset >= replay->size) return false;
+        const uint8_t *run = replay->data + replay->offset;
+        replay->bits = run[0];
+        replay->remaining = run[1] | run[2] << 8;
+        replay->offset += REPLAY_RUN_SIZE;
+    }
+
+    replay->remaining--;
+    *input = UnpackPlayerInput(replay->bits);
+    return true;
+}
+
+void UnloadInputReplay(InputReplay *replay) {
+    free(replay->data);
+    replay->data = NULL;
+    replay->size = 0;
+}
@@ -0,0 +1,60 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "input.h"
+
+// -----------------------------------------------------------------------------
+// Input recording and replay
+// -----------------------------------------------------------------------------
+// A replay is the seed and wave script of a run plus the packed input of
+// every simulation tick, run-length encoded since held buttons change
+// rarely. Because the simulation only advances in fixed SIM_DT ticks,
+// feeding the same inputs back reproduces the run exactly, windowed or
+// headless.
+//
+// File layout (little endian):
+//     "SHMUPRP1"            magic and version
+//     u64 seed
+//     u16 length, bytes     wave script path
+//     { u8 input, u16 run } until end of file
+
+#define REPLAY_MAX_PATH 256
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct InputRecorder {
+    FILE *file;
+    uint8_t bits;   // Input of the pending run
+    uint16_t run;   // Ticks in the pending run
+    long ticks;
+} InputRecorder;
+
+typedef struct InputReplay {
+    uint64_t seed;
+    char wavePath[REPLAY_MAX_PATH];
+    uint8_t *data;  // Encoded runs, whole file body
+    long size;
+    long offset;    // Next run in data
+    uint8_t bits;   // Input of the current run
+    int remaining;  // Ticks left in the current run
+    long ticks;     // Total ticks in the replay
+} InputReplay;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+bool BeginInputRecording(InputRecorder *recorder, const char *path, uint64_t seed, const char *wavePath);
+void RecordInput(InputRecorder *recorder, PlayerInput input);
+void EndInputRecording(InputRecorder *recorder);
+
+bool LoadInputReplay(InputReplay *replay, const char *path);
+// Next tick's input; false once the replay is exhausted
+bool NextReplayInput(InputReplay *replay, PlayerInput *input);
+void UnloadInputReplay(InputReplay *replay);
+
+#endif // REPLAY_H
@@ -0,0 +1,72 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Deterministic random numbers
+// -----------------------------------------------------------------------------
+// xoshiro128** seeded through splitmix64. The sequence depends only on the
+// seed, so runs are bit-for-bit reproducible on every platform, unlike
+// GetRandomValue which goes through libc rand().
+
+typedef struct Rng {
+    uint32_t s[4];
+} Rng;
+
+static inline uint32_t RngRotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline void RngSeed(Rng *rng, uint64_t seed) {
+    // splitmix64 spreads any seed (including 0) over the full state
+    for (int i = 0; i < 4; i += 2) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        rng->s[i] = (uint32_t)z;
+        rng->s[i + 1] = (uint32_t)(z >> 32);
+    }
+}
+
+static inline uint32_t RngNext(Rng *rng) {
+    uint32_t *s = rng->s;
+    uint32_t result = RngRotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = RngRotl(s[3], 11);
+
+    return result;
+}
+
+// Uniform float in [0, 1) from the top 24 bits
+static inline float RngFloat(Rng *rng) {
+    return (float)(RngNext(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform float in [min, max)
+static inline float RngRange(Rng *rng, float min, float max) {
+    return min + (max - min) * RngFloat(rng);
+}
+
+// Uniform integer in [min, max], both included
+static inline int RngInt(Rng *rng, int min, int max) {
+    uint32_t span = (uint32_t)(max - min) + 1u;
+    return min + (int)(((uint64_t)RngNext(rng) * span) >> 32);
+}
+
+// Fill out[0..n) with uniform floats in [min, max)
+static inline void RngFillRange(Rng *rng, float *out, int n, float min, float max) {
+    float scale = (max - min) * (1.0f / 16777216.0f);
+    for (int i = 0; i < n; i++) {
+        out[i] = min + (float)(RngNext(rng) >> 8) * scale;
+    }
+}
+
+#endif // RNG_H
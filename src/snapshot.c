@@ -0,0 +1,93 @@
+#include "snapshot.h"
+
+#include <string.h>
+
+#include "profiler.h"
+
+#define SNAPSHOT_FRESH 0x4 // Set in middle by the writer, cleared by the reader
+#define SNAPSHOT_INDEX 0x3
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+#define COPY_LIVE(dst, src, field, n) memcpy((dst)->field, (src)->field, sizeof((src)->field[0]) * (size_t)(n))
+
+static void CopyParticleSpan(ParticlePool *dst, int start, int end) {
+    int n = end - start;
+    memcpy(dst->x + start, particles.x + start, sizeof(float) * n);
+    memcpy(dst->y + start, particles.y + start, sizeof(float) * n);
+    memcpy(dst->vx + start, particles.vx + start, sizeof(float) * n);
+    memcpy(dst->vy + start, particles.vy + start, sizeof(float) * n);
+    memcpy(dst->life + start, particles.life + start, sizeof(float) * n);
+    memcpy(dst->invLife + start, particles.invLife + start, sizeof(float) * n);
+    memcpy(dst->size + start, particles.size + start, sizeof(float) * n);
+    memcpy(dst->color + start, particles.color + start, sizeof(Color) * n);
+}
+
+// -----------------------------------------------------------------------------
+// Snapshot Functions
+// -----------------------------------------------------------------------------
+void InitSnapshotBuffer(SnapshotBuffer *buffer) {
+    buffer->back = 0;
+    buffer->middle = 1;
+    buffer->front = 2;
+    for (int s = 0; s < SNAPSHOT_SLOTS; s++) {
+        SimSnapshot *slot = &buffer->slots[s];
+        slot->tick = 0;
+        slot->bullets.count = slot->enemies.count = slot->particles.count = 0;
+        slot->entities.archetypeCount = 0;
+        memcpy(slot->starLayers, stars.layers, sizeof(stars.layers));
+    }
+}
+
+SimSnapshot *BeginSnapshot(SnapshotBuffer *buffer) {
+    return &buffer->slots[buffer->back];
+}
+
+void CaptureSnapshotPools(SimSnapshot *snapshot) {
+    BulletPool *b = &snapshot->bullets;
+    b->count = bullets.count;
+    COPY_LIVE(b, &bullets, x, b->count);
+    COPY_LIVE(b, &bullets, y, b->count);
+    COPY_LIVE(b, &bullets, vx, b->count);
+    COPY_LIVE(b, &bullets, vy, b->count);
+
+    memcpy(snapshot->starLayers, stars.layers, sizeof(stars.layers));
+
+    EnemyPool *e = &snapshot->enemies;
+    e->count = enemies.count;
+    COPY_LIVE(e, &enemies, x, e->count);
+    COPY_LIVE(e, &enemies, y, e->count);
+    COPY_LIVE(e, &enemies, prevX, e->count);
+    COPY_LIVE(e, &enemies, prevY, e->count);
+
+    // The particle ring keeps its slot layout, so the copy is the live
+    // window's one or two spans
+    ParticlePool *p = &snapshot->particles;
+    p->tail = particles.tail;
+    p->count = particles.count;
+    int end = particles.tail + particles.count;
+    if (end <= MAX_PARTICLES) {
+        CopyParticleSpan(p, particles.tail, end);
+    } else {
+        CopyParticleSpan(p, particles.tail, MAX_PARTICLES);
+        CopyParticleSpan(p, 0, end - MAX_PARTICLES);
+    }
+
+    CopyStorage(&snapshot->entities, &world.storage, ECS_MASK(COMPONENT_POSITION) | ECS_MASK(COMPONENT_SPRITE));
+}
+
+void PublishSnapshot(SnapshotBuffer *buffer) {
+    buffer->slots[buffer->back].publishedNs = ProfileNowNs();
+    // Release: the slot's contents are visible before the reader can take it
+    int previous = __atomic_exchange_n(&buffer->middle, buffer->back | SNAPSHOT_FRESH, __ATOMIC_ACQ_REL);
+    buffer->back = previous & SNAPSHOT_INDEX;
+}
+
+const SimSnapshot *AcquireSnapshot(SnapshotBuffer *buffer) {
+    if (__atomic_load_n(&buffer->middle, __ATOMIC_ACQUIRE) & SNAPSHOT_FRESH) {
+        int previous = __atomic_exchange_n(&buffer->middle, buffer->front, __ATOMIC_ACQ_REL);
+        buffer->front = previous & SNAPSHOT_INDEX;
+    }
+    return &buffer->slots[buffer->front];
+}
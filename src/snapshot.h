@@ -0,0 +1,62 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "raylib.h"
+#include <stdint.h>
+
+#include "bullets.h"
+#include "ecs.h"
+#include "enemies.h"
+#include "particles.h"
+#include "stars.h"
+
+// -----------------------------------------------------------------------------
+// Simulation snapshots
+// -----------------------------------------------------------------------------
+// The simulation thread copies everything the renderer reads into a
+// snapshot after every tick and publishes it through a triple buffer. The
+// render thread always draws the newest complete snapshot and never sees a
+// half-written one; neither side ever waits on the other. Only the live
+// range of each pool is copied.
+
+#define SNAPSHOT_SLOTS 3
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct SimSnapshot {
+    uint64_t tick;
+    uint64_t publishedNs;       // ProfileNowNs when published, for interpolation
+    Vector2 shipPosition;
+    Vector2 shipPreviousPosition;
+    Rectangle shipSource;       // Atlas rectangle of the ship's animation frame
+    float shipScale;
+    BulletPool bullets;         // x, y, vx, vy
+    StarLayer starLayers[STAR_LAYERS]; // The star pattern is immutable, only offsets move
+    EnemyPool enemies;          // x, y, prevX, prevY
+    ParticlePool particles;     // Everything but the dead part of the ring
+    EcsStorage entities;        // Chunks of the archetypes that have sprites
+} SimSnapshot;
+
+// Each slot is owned by exactly one role at a time: the writer's back slot,
+// the reader's front slot, and the last published one in between. Roles
+// move by swapping indices, never by copying snapshots.
+typedef struct SnapshotBuffer {
+    SimSnapshot slots[SNAPSHOT_SLOTS];
+    int back;     // Writer only
+    int front;    // Reader only
+    int middle;   // Shared, swapped atomically; SNAPSHOT_FRESH while unread
+} SnapshotBuffer;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+void InitSnapshotBuffer(SnapshotBuffer *buffer);
+// Writer: fill the back slot from the live pools, then hand it over
+SimSnapshot *BeginSnapshot(SnapshotBuffer *buffer);
+void CaptureSnapshotPools(SimSnapshot *snapshot);
+void PublishSnapshot(SnapshotBuffer *buffer);
+// Reader: the newest published snapshot, stable until the next call
+const SimSnapshot *AcquireSnapshot(SnapshotBuffer *buffer);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,227 @@
+#include "spatial_hash.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static int CellCoord(float v, int cells) {
+    int c = (int)(v * (1.0f / SPATIAL_HASH_CELL_SIZE));
+    if (v < 0.0f || c < 0) return 0;
+    if (c >= cells) return cells - 1;
+    return c;
+}
+
+static int Overlaps(float ax, float ay, float bx, float by, float reach) {
+    float dx = ax - bx;
+    float dy = ay - by;
+    return dx * dx + dy * dy <= reach * reach;
+}
+
+static SweepTarget TargetAt(const SpatialHash *hash, int t, float bulletRadius) {
+    return (SweepTarget){
+        .x = hash->x[t],
+        .y = hash->y[t],
+        .dx = hash->x[t] - hash->prevX[t],
+        .dy = hash->y[t] - hash->prevY[t],
+        .radius = bulletRadius + hash->radius[t],
+        .id = t,
+    };
+}
+
+// Sweep bullets [first, first + n) against every target near any of their
+// segments, each target once. Gives up without testing anything when that
+// is more than maxCells cells.
+static bool SweepSpan(const SpatialHash *hash,
+                      const float *bx, const float *by, const float *bvx, const float *bvy, float dt,
+                      float bulletRadius, int first, int n, int maxCells, int *hit, float *toi) {
+    float minX = bx[first], maxX = bx[first];
+    float minY = by[first], maxY = by[first];
+    for (int b = first; b < first + n; b++) {
+        float startX = bx[b] - bvx[b] * dt;
+        float startY = by[b] - bvy[b] * dt;
+        if (bx[b] < minX) minX = bx[b];
+        if (bx[b] > maxX) maxX = bx[b];
+        if (startX < minX) minX = startX;
+        if (startX > maxX) maxX = startX;
+        if (by[b] < minY) minY = by[b];
+        if (by[b] > maxY) maxY = by[b];
+        if (startY < minY) minY = startY;
+        if (startY > maxY) maxY = startY;
+    }
+
+    // A moving target is within maxTravel of where it was bucketed
+    float reach = bulletRadius + hash->maxRadius + hash->maxTravel;
+
+    // A lone bullet's segment fits in a circle around its midpoint; any
+    // target it can touch overlaps that circle grown by the target's reach
+    float halfX = bvx[first] * dt * 0.5f;
+    float halfY = bvy[first] * dt * 0.5f;
+    float midX = bx[first] - halfX;
+    float midY = by[first] - halfY;
+    float bound = sqrtf(halfX * halfX + halfY * halfY) + hash->maxTravel;
+    int col0 = CellCoord(minX - reach, SPATIAL_HASH_COLS);
+    int col1 = CellCoord(maxX + reach, SPATIAL_HASH_COLS);
+    int row0 = CellCoord(minY - reach, SPATIAL_HASH_ROWS);
+    int row1 = CellCoord(maxY + reach, SPATIAL_HASH_ROWS);
+    if ((col1 - col0 + 1) * (row1 - row0 + 1) > maxCells) return false;
+
+    for (int row = row0; row <= row1; row++) {
+        for (int col = col0; col <= col1; col++) {
+            int cell = row * SPATIAL_HASH_COLS + col;
+            for (int k = hash->cellStart[cell]; k < hash->cellStart[cell + 1]; k++) {
+                SweepTarget target = TargetAt(hash, hash->order[k], bulletRadius);
+                if (n == 1) {
+                    // Cheap reject first, since most candidates are nowhere
+                    // near; the vector path would only run its scalar tail
+                    if (!Overlaps(midX, midY, target.x, target.y, target.radius + bound)) continue;
+                    SweepCircleScalar(bx + first, by + first, bvx + first, bvy + first, 1, dt, &target,
+                                      toi + first, hit + first);
+                } else {
+                    SweepCircle(bx + first, by + first, bvx + first, bvy + first, n, dt, &target,
+                                toi + first, hit + first);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static int CountSweptHits(const int *hit, int bulletCount) {
+    int hits = 0;
+    for (int b = 0; b < bulletCount; b++) {
+        hits += hit[b] >= 0;
+    }
+    return hits;
+}
+
+// -----------------------------------------------------------------------------
+// Spatial Hash Functions
+// -----------------------------------------------------------------------------
+void BuildSpatialHash(SpatialHash *hash, const float *x, const float *y, const float *radius, int count) {
+    // Only guards the arrays; callers check their pool fits at compile time
+    if (count > SPATIAL_HASH_MAX_TARGETS) count = SPATIAL_HASH_MAX_TARGETS;
+
+    hash->x = x;
+    hash->y = y;
+    hash->radius = radius;
+    hash->prevX = x;
+    hash->prevY = y;
+    hash->count = count;
+    hash->maxRadius = 0.0f;
+    hash->maxTravel = 0.0f;
+
+    // Counting sort by cell: histogram, prefix sum, scatter
+    memset(hash->cellStart, 0, sizeof(hash->cellStart));
+    for (int i = 0; i < count; i++) {
+        int cell = CellCoord(y[i], SPATIAL_HASH_ROWS) * SPATIAL_HASH_COLS + CellCoord(x[i], SPATIAL_HASH_COLS);
+        hash->targetCell[i] = cell;
+        hash->cellStart[cell + 1]++;
+        if (radius[i] > hash->maxRadius) hash->maxRadius = radius[i];
+    }
+    for (int c = 0; c < SPATIAL_HASH_CELLS; c++) {
+        hash->cellStart[c + 1] += hash->cellStart[c];
+    }
+
+    int cursor[SPATIAL_HASH_CELLS];
+    memcpy(cursor, hash->cellStart, sizeof(cursor));
+    for (int i = 0; i < count; i++) {
+        hash->order[cursor[hash->targetCell[i]]++] = i;
+    }
+}
+
+void BuildSweptSpatialHash(SpatialHash *hash, const float *x, const float *y, const float *prevX,
+                           const float *prevY, const float *radius, int count) {
+    BuildSpatialHash(hash, x, y, radius, count);
+    hash->prevX = prevX;
+    hash->prevY = prevY;
+    for (int i = 0; i < hash->count; i++) {
+        float dx = x[i] - prevX[i];
+        float dy = y[i] - prevY[i];
+        float travel = sqrtf(dx * dx + dy * dy);
+        if (travel > hash->maxTravel) hash->maxTravel = travel;
+    }
+}
+
+int QueryCollisionPairs(const SpatialHash *hash,
+                        const float *bx, const float *by, float bulletRadius, int bulletCount,
+                        CollisionPair *pairs, int maxPairs) {
+    int found = 0;
+    float reach = bulletRadius + hash->maxRadius;
+
+    for (int b = 0; b < bulletCount; b++) {
+        int col0 = CellCoord(bx[b] - reach, SPATIAL_HASH_COLS);
+        int col1 = CellCoord(bx[b] + reach, SPATIAL_HASH_COLS);
+        int row0 = CellCoord(by[b] - reach, SPATIAL_HASH_ROWS);
+        int row1 = CellCoord(by[b] + reach, SPATIAL_HASH_ROWS);
+
+        for (int row = row0; row <= row1; row++) {
+            for (int col = col0; col <= col1; col++) {
+                int cell = row * SPATIAL_HASH_COLS + col;
+                for (int k = hash->cellStart[cell]; k < hash->cellStart[cell + 1]; k++) {
+                    int t = hash->order[k];
+                    if (!Overlaps(bx[b], by[b], hash->x[t], hash->y[t], bulletRadius + hash->radius[t])) continue;
+                    if (found < maxPairs) pairs[found] = (CollisionPair){ b, t };
+                    found++;
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+int BruteForceCollisionPairs(const float *tx, const float *ty, const float *radius, int targetCount,
+                             const float *bx, const float *by, float bulletRadius, int bulletCount,
+                             CollisionPair *pairs, int maxPairs) {
+    int found = 0;
+    for (int b = 0; b < bulletCount; b++) {
+        for (int t = 0; t < targetCount; t++) {
+            if (!Overlaps(bx[b], by[b], tx[t], ty[t], bulletRadius + radius[t])) continue;
+            if (found < maxPairs) pairs[found] = (CollisionPair){ b, t };
+            found++;
+        }
+    }
+    return found;
+}
+
+int QuerySweptHits(const SpatialHash *hash,
+                   const float *bx, const float *by, const float *bvx, const float *bvy, float dt,
+                   float bulletRadius, int bulletCount, int *hit, float *toi) {
+    for (int b = 0; b < bulletCount; b++) {
+        hit[b] = -1;
+        toi[b] = SWEEP_MISS;
+    }
+
+    for (int first = 0; first < bulletCount; first += SWEEP_BATCH) {
+        int n = bulletCount - first < SWEEP_BATCH ? bulletCount - first : SWEEP_BATCH;
+        if (SweepSpan(hash, bx, by, bvx, bvy, dt, bulletRadius, first, n, SWEEP_BATCH_MAX_CELLS, hit, toi)) continue;
+        // Scattered batch: its union box would pull in targets no lane can reach
+        for (int b = first; b < first + n; b++) {
+            SweepSpan(hash, bx, by, bvx, bvy, dt, bulletRadius, b, 1, INT_MAX, hit, toi);
+        }
+    }
+
+    return CountSweptHits(hit, bulletCount);
+}
+
+int BruteForceSweptHits(const float *tx, const float *ty, const float *prevX, const float *prevY,
+                        const float *radius, int targetCount,
+                        const float *bx, const float *by, const float *bvx, const float *bvy, float dt,
+                        float bulletRadius, int bulletCount, int *hit, float *toi) {
+    for (int b = 0; b < bulletCount; b++) {
+        hit[b] = -1;
+        toi[b] = SWEEP_MISS;
+    }
+    for (int t = 0; t < targetCount; t++) {
+        SweepTarget target = {
+            .x = tx[t], .y = ty[t], .dx = tx[t] - prevX[t], .dy = ty[t] - prevY[t],
+            .radius = bulletRadius + radius[t], .id = t,
+        };
+        SweepCircleScalar(bx, by, bvx, bvy, bulletCount, dt, &target, toi, hit);
+    }
+    return CountSweptHits(hit, bulletCount);
+}
@@ -0,0 +1,91 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include "config.h"
+#include "kernels.h"
+
+// -----------------------------------------------------------------------------
+// Uniform-grid broadphase over the play field
+// -----------------------------------------------------------------------------
+// Targets (circles) are bucketed by the cell of their center with a counting
+// sort, so a rebuild is O(targets) with no allocation. A bullet then visits
+// only the cells within reach of its radius plus the largest target radius,
+// so every target is seen at most once per bullet. Positions outside the
+// field clamp to the border cells.
+//
+// The swept queries test the segment each bullet covered this tick, relative
+// to each target's own motion, so fast bullets cannot step over a target
+// between ticks. They take bullets in batches of SWEEP_BATCH consecutive
+// slots: the batch visits the cells around all of its segments together and
+// tests every candidate against all lanes at once with the SweepCircle
+// kernel. Bullets fired together sit next to each other in the pool, so a
+// batch usually spans a handful of cells; one that spans more than
+// SWEEP_BATCH_MAX_CELLS falls back to one bullet at a time.
+
+#define SPATIAL_HASH_CELL_SIZE 32
+#define SPATIAL_HASH_COLS ((SCREEN_WIDTH + SPATIAL_HASH_CELL_SIZE - 1) / SPATIAL_HASH_CELL_SIZE)
+#define SPATIAL_HASH_ROWS ((SCREEN_HEIGHT + SPATIAL_HASH_CELL_SIZE - 1) / SPATIAL_HASH_CELL_SIZE)
+#define SPATIAL_HASH_CELLS (SPATIAL_HASH_COLS * SPATIAL_HASH_ROWS)
+#ifndef SPATIAL_HASH_MAX_TARGETS
+#define SPATIAL_HASH_MAX_TARGETS 4096 // Raise with the target pool; enemies.c checks MAX_ENEMIES fits
+#endif
+#define SWEEP_BATCH 8
+#define SWEEP_BATCH_MAX_CELLS 16
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct CollisionPair {
+    int bullet;
+    int target;
+} CollisionPair;
+
+typedef struct SpatialHash {
+    int cellStart[SPATIAL_HASH_CELLS + 1];   // Targets of cell c are order[cellStart[c]..cellStart[c+1])
+    int order[SPATIAL_HASH_MAX_TARGETS];     // Target indices sorted by cell
+    int targetCell[SPATIAL_HASH_MAX_TARGETS];
+    const float *x;                          // Target arrays, borrowed until the next rebuild
+    const float *y;
+    const float *radius;
+    const float *prevX;                      // Target positions a tick ago, for the swept queries
+    const float *prevY;
+    float maxRadius;
+    float maxTravel;                         // Furthest any target moved over the tick
+    int count;
+} SpatialHash;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+// Rebuild from count circles; the arrays must stay valid while querying
+void BuildSpatialHash(SpatialHash *hash, const float *x, const float *y, const float *radius, int count);
+// Same, for targets that moved from (prevX, prevY) this tick
+void BuildSweptSpatialHash(SpatialHash *hash, const float *x, const float *y, const float *prevX,
+                           const float *prevY, const float *radius, int count);
+
+// Write every (bullet, target) pair whose circles overlap, up to maxPairs.
+// Returns the number of overlapping pairs found, which may exceed maxPairs.
+int QueryCollisionPairs(const SpatialHash *hash,
+                        const float *bx, const float *by, float bulletRadius, int bulletCount,
+                        CollisionPair *pairs, int maxPairs);
+
+// O(bullets x targets) reference with the same contract, kept as the oracle
+int BruteForceCollisionPairs(const float *tx, const float *ty, const float *radius, int targetCount,
+                             const float *bx, const float *by, float bulletRadius, int bulletCount,
+                             CollisionPair *pairs, int maxPairs);
+
+// Swept query: bullet b ended the tick at (bx, by) after moving (bvx, bvy) * dt.
+// Writes hit[b] = the target its path touched first, or -1, and toi[b] = the
+// fraction of the tick at which it did (SWEEP_MISS on a miss). Returns the
+// number of bullets that hit something.
+int QuerySweptHits(const SpatialHash *hash,
+                   const float *bx, const float *by, const float *bvx, const float *bvy, float dt,
+                   float bulletRadius, int bulletCount, int *hit, float *toi);
+
+// Every bullet against every target with the scalar kernel, as the oracle
+int BruteForceSweptHits(const float *tx, const float *ty, const float *prevX, const float *prevY,
+                        const float *radius, int targetCount,
+                        const float *bx, const float *by, const float *bvx, const float *bvy, float dt,
+                        float bulletRadius, int bulletCount, int *hit, float *toi);
+
+#endif // SPATIAL_HASH_H
@@ -0,0 +1,188 @@
+#include "stars.h"
+#include "rng.h"
+#include "atlas.h"
+#include <math.h>
+#include <stddef.h>
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef struct StarLayerStyle {
+    float share;    // Fraction of the stars in this layer
+    float speed;    // Fraction of BASE_STAR_SCROLL_SPEED
+    int size;
+    Color color;
+} StarLayerStyle;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+StarField stars;
+StarTiles starTiles;
+
+// Far to near: many small dim slow stars, few large bright fast ones
+static const StarLayerStyle layerStyles[STAR_LAYERS] = {
+    { 0.5f, 0.2f, STAR_MIN_SIZE, { 80, 80, 80, 255 } },
+    { 0.3f, 0.45f, STAR_MIN_SIZE + 1, { 130, 130, 130, 255 } },
+    { 0.2f, 1.0f, STAR_MAX_SIZE, { 190, 190, 190, 255 } },
+};
+
+// -----------------------------------------------------------------------------
+// Star Functions
+// -----------------------------------------------------------------------------
+void InitStars(uint64_t seed, int count) {
+    Rng rng;
+    RngSeed(&rng, seed);
+    if (count > MAX_STARS) count = MAX_STARS;
+    if (count < 0) count = 0;
+    stars.count = count;
+
+    RngFillRange(&rng, stars.x, count, 0.0f, SCREEN_WIDTH);
+    RngFillRange(&rng, stars.y, count, 0.0f, STAR_TILE_HEIGHT);
+
+    // Split the pattern into consecutive per-layer slices; the nearest
+    // layer takes the rounding remainder
+    int first = 0;
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        const StarLayerStyle *style = &layerStyles[l];
+        StarLayer *layer = &stars.layers[l];
+        layer->first = first;
+        layer->count = l == STAR_LAYERS - 1 ? count - first : (int)(count * style->share);
+        layer->speed = BASE_STAR_SCROLL_SPEED * style->speed;
+        layer->offset = 0.0f;
+        layer->size = style->size;
+        layer->color = style->color;
+        first += layer->count;
+    }
+}
+
+void UpdateStars(float deltaTime) {
+    // Scrolling is per layer; the stars themselves never change
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        StarLayer *layer = &stars.layers[l];
+        layer->offset = fmodf(layer->offset + layer->speed * deltaTime, STAR_TILE_HEIGHT);
+    }
+}
+
+uint32_t StarFieldChecksum(void) {
+    // FNV-1a over the pattern and the layer offsets, for comparing runs bit
+    // for bit
+    uint32_t hash = 2166136261u;
+    const unsigned char *arrays[] = { (const unsigned char *)stars.x, (const unsigned char *)stars.y };
+    for (int a = 0; a < 2; a++) {
+        for (size_t i = 0; i < sizeof(float) * stars.count; i++) {
+            hash = (hash ^ arrays[a][i]) * 16777619u;
+        }
+    }
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        const unsigned char *offset = (const unsigned char *)&stars.layers[l].offset;
+        for (size_t i = 0; i < sizeof(float); i++) {
+            hash = (hash ^ offset[i]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+// -----------------------------------------------------------------------------
+// Star Rendering
+// -----------------------------------------------------------------------------
+static float LayerShift(const StarLayer *layer, float alpha) {
+    // Back-step interpolation like the bullets, kept in [0, STAR_TILE_HEIGHT)
+    float shift = layer->offset - layer->speed * (1.0f - alpha) * SIM_DT;
+    return shift < 0.0f ? shift + STAR_TILE_HEIGHT : shift;
+}
+
+static float WrapStarY(float patternY, float shift) {
+    // Both terms are in [0, STAR_TILE_HEIGHT), so one subtraction wraps
+    float y = patternY + shift;
+    if (y >= STAR_TILE_HEIGHT) y -= STAR_TILE_HEIGHT;
+    return y - STAR_MAX_SIZE;
+}
+
+void DrawStars(const StarLayer *layers, float alpha) {
+    // Each star is one quad of its layer's atlas circle. All quads share
+    // the atlas texture, so the whole field lands in the same batch rather
+    // than one triangle fan per star.
+    if (!atlas.loaded) {
+        DrawStarsReference(layers, alpha);
+        return;
+    }
+
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        const StarLayer *layer = &layers[l];
+        Rectangle frame = atlas.frames[SPRITE_STAR_SMALL + layer->size - STAR_MIN_SIZE];
+        float half = frame.width / 2.0f;
+        float shift = LayerShift(layer, alpha);
+        for (int i = layer->first; i < layer->first + layer->count; i++) {
+            DrawTextureRec(atlas.texture, frame, (Vector2){ stars.x[i] - half, WrapStarY(stars.y[i], shift) - half },
+                           layer->color);
+        }
+    }
+}
+
+void DrawStarsBaked(const StarLayer *layers, float alpha) {
+    if (!starTiles.loaded) {
+        DrawStars(layers, alpha);
+        return;
+    }
+
+    // The tile holds the pattern at shift 0, so placing it at the shift and
+    // again one tile above covers the screen with the wrapped pattern.
+    // Render textures are stored bottom-up, hence the negative height. Baking
+    // onto a transparent target left the colours multiplied by alpha.
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        Texture2D tile = starTiles.layers[l].texture;
+        Rectangle source = { 0.0f, 0.0f, (float)tile.width, -(float)tile.height };
+        float top = LayerShift(&layers[l], alpha) - STAR_MAX_SIZE;
+        DrawTextureRec(tile, source, (Vector2){ 0.0f, top }, WHITE);
+        DrawTextureRec(tile, source, (Vector2){ 0.0f, top - STAR_TILE_HEIGHT }, WHITE);
+    }
+    EndBlendMode();
+}
+
+bool BakeStarTiles(void) {
+    UnloadStarTiles();
+    if (!atlas.loaded) return false;
+
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        const StarLayer *layer = &stars.layers[l];
+        Rectangle frame = atlas.frames[SPRITE_STAR_SMALL + layer->size - STAR_MIN_SIZE];
+        float half = frame.width / 2.0f;
+
+        starTiles.layers[l] = LoadRenderTexture(SCREEN_WIDTH, STAR_TILE_HEIGHT);
+        BeginTextureMode(starTiles.layers[l]);
+        ClearBackground(BLANK);
+        for (int i = layer->first; i < layer->first + layer->count; i++) {
+            // Stars near the seam are also drawn one tile up and down, so
+            // the circles stay whole where the two quads meet
+            for (int wrap = -1; wrap <= 1; wrap++) {
+                Vector2 position = { stars.x[i] - half, stars.y[i] + wrap * STAR_TILE_HEIGHT - half };
+                DrawTextureRec(atlas.texture, frame, position, layer->color);
+            }
+        }
+        EndTextureMode();
+    }
+
+    starTiles.loaded = true;
+    return true;
+}
+
+void UnloadStarTiles(void) {
+    if (!starTiles.loaded) return;
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        UnloadRenderTexture(starTiles.layers[l]);
+    }
+    starTiles.loaded = false;
+}
+
+void DrawStarsReference(const StarLayer *layers, float alpha) {
+    // Draw each star as a small circle
+    for (int l = 0; l < STAR_LAYERS; l++) {
+        const StarLayer *layer = &layers[l];
+        float shift = LayerShift(layer, alpha);
+        for (int i = layer->first; i < layer->first + layer->count; i++) {
+            DrawCircleV((Vector2){ stars.x[i], WrapStarY(stars.y[i], shift) }, (float)layer->size, layer->color);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef STARS_H
+#define STARS_H
+
+#include "raylib.h"
+#include "config.h"
+#include <stdint.h>
+
+#define STAR_MIN_SIZE 1
+#define STAR_MAX_SIZE 3
+#define STAR_SIZE_BUCKETS (STAR_MAX_SIZE - STAR_MIN_SIZE + 1)
+#define STAR_LAYERS 3
+// Vertical period of each layer's pattern. One star radius of slack above
+// and below the screen, so stars wrap while they are out of view.
+#define STAR_TILE_HEIGHT (SCREEN_HEIGHT + 2 * STAR_MAX_SIZE)
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+// One parallax layer: a fixed slice of the star pattern that scrolls as a
+// whole. Only offset changes after InitStars.
+typedef struct StarLayer {
+    int first;      // Stars [first, first + count) of the pattern
+    int count;
+    float speed;    // px/s; slower layers read as further away
+    float offset;   // Scroll position in [0, STAR_TILE_HEIGHT)
+    int size;       // Radius, STAR_MIN_SIZE..STAR_MAX_SIZE
+    Color color;
+} StarLayer;
+
+// Layered parallax starfield. Star positions are a pattern generated once
+// per seed and never written again; each frame a star is drawn at its
+// pattern y plus its layer's offset, modulo STAR_TILE_HEIGHT. Scrolling is
+// one add per layer, with no per-star update and no respawning, so the
+// update cost does not grow with the star count.
+typedef struct StarField {
+    float x[MAX_STARS];
+    float y[MAX_STARS];   // In [0, STAR_TILE_HEIGHT)
+    StarLayer layers[STAR_LAYERS];
+    int count;
+} StarField;
+
+// Each layer's pattern pre-rendered once into a transparent texture one
+// tile tall, so the background costs two quads per layer however many
+// stars there are. Needs a GL context; rebake after InitStars.
+typedef struct StarTiles {
+    RenderTexture2D layers[STAR_LAYERS];
+    bool loaded;
+} StarTiles;
+
+// -----------------------------------------------------------------------------
+// Globals
+// -----------------------------------------------------------------------------
+extern StarField stars;
+extern StarTiles starTiles;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+// Same seed, same pattern, on every platform. count is clamped to MAX_STARS.
+void InitStars(uint64_t seed, int count);
+void UpdateStars(float deltaTime);
+uint32_t StarFieldChecksum(void);
+// layers is stars.layers or a snapshot copy of it; the pattern itself is
+// read from stars, which is safe from any thread once InitStars returns.
+// alpha in [0, 1] is how far the render time sits between the previous and
+// the current simulation tick
+void DrawStars(const StarLayer *layers, float alpha);
+void DrawStarsReference(const StarLayer *layers, float alpha);
+
+bool BakeStarTiles(void);
+void UnloadStarTiles(void);
+// Same picture as DrawStars from the baked tiles; falls back to DrawStars
+// when no tiles are loaded
+void DrawStarsBaked(const StarLayer *layers, float alpha);
+
+#endif // STARS_H
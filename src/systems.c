@@ -0,0 +1,79 @@
+#include "systems.h"
+
+#include <stddef.h>
+
+#include "atlas.h"
+#include "config.h"
+
+// -----------------------------------------------------------------------------
+// Systems
+// -----------------------------------------------------------------------------
+static void MoveSystem(void *context, EcsChunkView *chunk) {
+    float dt = *(const float *)context;
+    Vector2 *position = chunk->column[COMPONENT_POSITION];
+    const Vector2 *velocity = chunk->column[COMPONENT_VELOCITY];
+    Vector2 *previous = chunk->column[COMPONENT_PREVIOUS];
+    // The column test is per chunk, not per entity
+    if (previous != NULL) {
+        for (int i = 0; i < chunk->count; i++) {
+            previous[i] = position[i];
+        }
+    }
+    for (int i = 0; i < chunk->count; i++) {
+        position[i].x += velocity[i].x * dt;
+        position[i].y += velocity[i].y * dt;
+    }
+}
+
+static void ExpireSystem(void *context, EcsChunkView *chunk) {
+    float dt = *(const float *)context;
+    float *lifetime = chunk->column[COMPONENT_LIFETIME];
+    for (int i = 0; i < chunk->count; i++) {
+        lifetime[i] -= dt;
+        if (lifetime[i] <= 0.0f) DestroyEntityLater(chunk->entities[i]);
+    }
+}
+
+static void CullSystem(void *context, EcsChunkView *chunk) {
+    (void)context;
+    const Vector2 *position = chunk->column[COMPONENT_POSITION];
+    for (int i = 0; i < chunk->count; i++) {
+        if (position[i].x < -ENTITY_CULL_MARGIN || position[i].x > SCREEN_WIDTH + ENTITY_CULL_MARGIN ||
+            position[i].y < -ENTITY_CULL_MARGIN || position[i].y > SCREEN_HEIGHT + ENTITY_CULL_MARGIN) {
+            DestroyEntityLater(chunk->entities[i]);
+        }
+    }
+}
+
+static void DrawSpriteSystem(void *context, EcsChunkView *chunk) {
+    float alpha = *(const float *)context;
+    const Vector2 *position = chunk->column[COMPONENT_POSITION];
+    const Vector2 *previous = chunk->column[COMPONENT_PREVIOUS];
+    const EcsSprite *sprite = chunk->column[COMPONENT_SPRITE];
+    for (int i = 0; i < chunk->count; i++) {
+        Rectangle frame = atlas.frames[sprite[i].frame];
+        Vector2 at = position[i];
+        if (previous != NULL) {
+            at.x = previous[i].x + (position[i].x - previous[i].x) * alpha;
+            at.y = previous[i].y + (position[i].y - previous[i].y) * alpha;
+        }
+        at.x -= frame.width / 2.0f;
+        at.y -= frame.height / 2.0f;
+        DrawTextureRec(atlas.texture, frame, at, sprite[i].tint);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Update and Draw
+// -----------------------------------------------------------------------------
+void UpdateEntities(float deltaTime) {
+    RunSystem(&world.storage, ECS_MASK(COMPONENT_POSITION) | ECS_MASK(COMPONENT_VELOCITY), MoveSystem, &deltaTime);
+    RunSystem(&world.storage, ECS_MASK(COMPONENT_LIFETIME), ExpireSystem, &deltaTime);
+    RunSystem(&world.storage, ECS_MASK(COMPONENT_POSITION), CullSystem, NULL);
+    FlushDestroyedEntities();
+}
+
+void DrawEntitySprites(const EcsStorage *storage, float alpha) {
+    if (!atlas.loaded) return;
+    ForEachChunk(storage, ECS_MASK(COMPONENT_POSITION) | ECS_MASK(COMPONENT_SPRITE), DrawSpriteSystem, &alpha);
+}
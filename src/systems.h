@@ -0,0 +1,29 @@
+#ifndef SYSTEMS_H
+#define SYSTEMS_H
+
+#include "ecs.h"
+
+// -----------------------------------------------------------------------------
+// Systems shared by every kind of entity
+// -----------------------------------------------------------------------------
+// Each system runs over whichever archetypes carry its components, so an
+// object kind only adds systems for behavior no other kind has.
+//
+//     movement: POSITION, VELOCITY (PREVIOUS kept when present)
+//     expiry:   LIFETIME, destroyed once it runs out
+//     culling:  POSITION, destroyed once outside the field plus ENTITY_CULL_MARGIN
+//     drawing:  POSITION, SPRITE (interpolated when PREVIOUS is present)
+
+#define ENTITY_CULL_MARGIN 32.0f
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+// One simulation tick of movement, expiry and culling over the live world
+void UpdateEntities(float deltaTime);
+// Draw from the live storage or a snapshot copy of it (see snapshot.h).
+// alpha in [0, 1] is how far the render time sits between the previous and
+// the current simulation tick
+void DrawEntitySprites(const EcsStorage *storage, float alpha);
+
+#endif // SYSTEMS_H
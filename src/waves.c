@@ -0,0 +1,116 @@
+#include "waves.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "enemies.h"
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+static const char *patternNames[ENEMY_PATTERN_COUNT] = { "straight", "sine", "zigzag" };
+
+static bool ParsePattern(const char *name, EnemyPattern *pattern) {
+    for (int p = 0; p < ENEMY_PATTERN_COUNT; p++) {
+        if (strcmp(name, patternNames[p]) == 0) {
+            *pattern = (EnemyPattern)p;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void SpawnDueEvents(WaveScript *script) {
+    while (script->nextEvent < script->eventCount &&
+           script->events[script->nextEvent].time <= script->clock) {
+        const WaveEvent *event = &script->events[script->nextEvent++];
+        for (int i = 0; i < event->count; i++) {
+            SpawnEnemy(event->pattern, event->x + event->spacing * i, event->speed, event->hp, event->amplitude);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Wave Functions
+// -----------------------------------------------------------------------------
+bool LoadWaveScript(WaveScript *script, const char *path) {
+    memset(script, 0, sizeof(*script));
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "waves: cannot open %s\n", path);
+        return false;
+    }
+
+    char line[256];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lineNumber++;
+
+        char *comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        char word[32];
+        if (sscanf(line, "%31s", word) != 1) continue; // Blank line
+
+        if (strcmp(word, "loop") == 0) {
+            if (sscanf(line, "%*s %f", &script->loopTime) != 1 || script->loopTime <= 0.0f) {
+                fprintf(stderr, "waves: %s:%d: bad loop time\n", path, lineNumber);
+                script->loopTime = 0.0f;
+            }
+            continue;
+        }
+
+        if (script->eventCount >= MAX_WAVE_EVENTS) {
+            fprintf(stderr, "waves: %s:%d: more than %d events, ignoring the rest\n", path, lineNumber, MAX_WAVE_EVENTS);
+            break;
+        }
+
+        WaveEvent event = { 0 };
+        char pattern[32];
+        int fields = sscanf(line, "%f %31s %d %f %f %f %f %f", &event.time, pattern, &event.count,
+                            &event.x, &event.spacing, &event.speed, &event.hp, &event.amplitude);
+        if (fields < 7 || !ParsePattern(pattern, &event.pattern) || event.count <= 0) {
+            fprintf(stderr, "waves: %s:%d: malformed event\n", path, lineNumber);
+            continue;
+        }
+        if (script->eventCount > 0 && event.time < script->events[script->eventCount - 1].time) {
+            fprintf(stderr, "waves: %s:%d: events must be sorted by time\n", path, lineNumber);
+            continue;
+        }
+        script->events[script->eventCount++] = event;
+    }
+
+    fclose(file);
+
+    // The loop line may come anywhere in the file, so events past it are
+    // only known now; they would never fire
+    if (script->loopTime > 0.0f) {
+        int kept = 0;
+        for (int e = 0; e < script->eventCount; e++) {
+            if (script->events[e].time > script->loopTime) {
+                fprintf(stderr, "waves: %s: event at %.2f s is past the %.2f s loop, ignoring it\n", path,
+                        script->events[e].time, script->loopTime);
+                continue;
+            }
+            script->events[kept++] = script->events[e];
+        }
+        script->eventCount = kept;
+    }
+    return true;
+}
+
+void UpdateWaves(WaveScript *script, float deltaTime) {
+    if (script->eventCount == 0) return;
+
+    script->clock += deltaTime;
+    SpawnDueEvents(script);
+
+    // Events already due in the new pass (time 0 ones at least) fire this
+    // tick, not the next
+    while (script->loopTime > 0.0f && script->clock >= script->loopTime) {
+        script->clock -= script->loopTime;
+        script->nextEvent = 0;
+        SpawnDueEvents(script);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef WAVES_H
+#define WAVES_H
+
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+// Wave scripts
+// -----------------------------------------------------------------------------
+// A wave script is a text file, one spawn event per line, sorted by time:
+//
+//     # time  pattern  count  x    spacing  speed  hp  amplitude
+//     0.5     sine     6      120  110      140    2   60
+//     loop 10.0
+//
+// Each event spawns `count` enemies in a row starting at `x`, `spacing` px
+// apart, just above the top edge. `amplitude` is only read by the sine and
+// zigzag patterns and may be omitted. `loop T` restarts the script every T
+// seconds, which is what load tests want; events later than T are dropped
+// with a warning. Blank lines and # comments are ignored.
+
+#ifndef MAX_WAVE_EVENTS
+#define MAX_WAVE_EVENTS 256
+#endif
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+typedef enum EnemyPattern {
+    ENEMY_PATTERN_STRAIGHT = 0,
+    ENEMY_PATTERN_SINE,
+    ENEMY_PATTERN_ZIGZAG,
+    ENEMY_PATTERN_COUNT
+} EnemyPattern;
+
+typedef struct WaveEvent {
+    float time;
+    EnemyPattern pattern;
+    int count;
+    float x;
+    float spacing;
+    float speed;
+    float hp;
+    float amplitude;
+} WaveEvent;
+
+typedef struct WaveScript {
+    WaveEvent events[MAX_WAVE_EVENTS];
+    int eventCount;
+    float loopTime;  // 0 when the script plays once
+    float clock;     // Playback position in seconds
+    int nextEvent;
+} WaveScript;
+
+// -----------------------------------------------------------------------------
+// Function Declarations
+// -----------------------------------------------------------------------------
+// Returns false and leaves an empty script when the file can't be read.
+// Malformed lines are reported on stderr and skipped.
+bool LoadWaveScript(WaveScript *script, const char *path);
+// Advance playback and spawn every event that came due
+void UpdateWaves(WaveScript *script, float deltaTime);
+
+#endif // WAVES_H
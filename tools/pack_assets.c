@@ -0,0 +1,97 @@
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "bundle.h"
+
+// -----------------------------------------------------------------------------
+// Offline asset packer
+// -----------------------------------------------------------------------------
+// usage: shmup_pack OUT.bundle IMAGE...
+//
+// Decodes every image once, converts it to RGBA8 and writes a bundle that the
+// game maps at startup (see src/bundle.h). Entries are named after the source
+// file without its extension, so assets/raw/ship_sheet.png is "ship_sheet".
+
+#define PACK_MAX_ENTRIES 256
+
+static BundleEntry entries[PACK_MAX_ENTRIES];
+static Image images[PACK_MAX_ENTRIES];
+
+static uint64_t AlignUp(uint64_t v) {
+    return (v + BUNDLE_ALIGNMENT - 1) & ~(uint64_t)(BUNDLE_ALIGNMENT - 1);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s OUT.bundle IMAGE...\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    int count = argc - 2;
+    if (count > PACK_MAX_ENTRIES) {
+        fprintf(stderr, "pack: at most %d images per bundle\n", PACK_MAX_ENTRIES);
+        return 1;
+    }
+
+    // Decode everything first so the index can be written up front
+    uint64_t offset = AlignUp(sizeof(BundleHeader) + sizeof(BundleEntry) * count);
+    for (int i = 0; i < count; i++) {
+        const char *source = argv[i + 2];
+        images[i] = LoadImage(source);
+        if (!IsImageValid(images[i])) {
+            fprintf(stderr, "pack: cannot decode %s\n", source);
+            return 1;
+        }
+        ImageFormat(&images[i], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        const char *name = GetFileNameWithoutExt(source);
+        if (strlen(name) >= BUNDLE_NAME_SIZE) {
+            fprintf(stderr, "pack: name too long: %s\n", name);
+            return 1;
+        }
+        for (int j = 0; j < i; j++) {
+            if (strcmp(entries[j].name, name) == 0) {
+                fprintf(stderr, "pack: duplicate asset name %s\n", name);
+                return 1;
+            }
+        }
+
+        BundleEntry *entry = &entries[i];
+        strcpy(entry->name, name);
+        entry->width = (uint32_t)images[i].width;
+        entry->height = (uint32_t)images[i].height;
+        entry->format = (uint32_t)images[i].format;
+        entry->offset = offset;
+        entry->size = (uint64_t)GetPixelDataSize(images[i].width, images[i].height, images[i].format);
+        offset = AlignUp(offset + entry->size);
+    }
+
+    FILE *file = fopen(argv[1], "wb");
+    if (file == NULL) {
+        fprintf(stderr, "pack: cannot create %s\n", argv[1]);
+        return 1;
+    }
+
+    BundleHeader header = { .entryCount = (uint32_t)count };
+    memcpy(header.magic, BUNDLE_MAGIC, BUNDLE_MAGIC_SIZE);
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(entries, sizeof(BundleEntry), count, file);
+
+    static const char zeros[BUNDLE_ALIGNMENT] = { 0 };
+    for (int i = 0; i < count; i++) {
+        long position = ftell(file);
+        fwrite(zeros, 1, entries[i].offset - position, file);
+        fwrite(images[i].data, 1, entries[i].size, file);
+        printf("pack: %-24s %4u x %-4u %8llu bytes\n", entries[i].name, entries[i].width, entries[i].height,
+               (unsigned long long)entries[i].size);
+        UnloadImage(images[i]);
+    }
+
+    fclose(file);
+    printf("pack: wrote %d assets to %s\n", count, argv[1]);
+    return 0;
+}